@@ -0,0 +1,260 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2020 Abderraouf Adjal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#include "SpritzChannel.h"
+
+#include <stddef.h> /* NULL, size_t */
+
+
+/* The labels absorbed after the key and nonce, By the keystream and by the MAC */
+#define SPRITZ_CHANNEL_CRYPT_LABEL 0x00
+#define SPRITZ_CHANNEL_MAC_LABEL   0x01
+
+
+/* Order the slot accesses before publishing an index, When there is more than one core.
+ * On AVR (One core) a compiler barrier is enough, So the compiler does not move
+ * the slot accesses across the index accesses (Like after inlining with -flto).
+ */
+#if defined(__ATOMIC_SEQ_CST) && !defined(__AVR__)
+# define SPRITZ_CHANNEL_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+# define SPRITZ_CHANNEL_FENCE() __asm__ __volatile__("" ::: "memory")
+#endif
+
+
+/* Crypt `len` bytes in place, The same keystream as spritz_crypt().
+ * spritz_crypt() is recorded by SPRITZ_STATS and recording is not safe in interrupts,
+ * So commit() and receive() use spritz_random8() (Not recorded) instead.
+ */
+static void
+channelCrypt(spritz_ctx *ctx, uint8_t *data, uint8_t len)
+{
+  uint8_t i;
+
+  for (i = 0; i < len; i++) {
+    data[i] ^= spritz_random8(ctx);
+  }
+}
+
+
+SpritzChannel::SpritzChannel(uint8_t *slots, uint8_t slotsCount, uint8_t slotSize)
+  : _slots(slots), _slots_count(slotsCount), _slot_size(slotSize),
+    _head(0), _tail(0), _rx_ready(0), _rx_error(0)
+{
+}
+
+uint8_t *
+SpritzChannel::slot(uint8_t index) const
+{
+  return _slots + (size_t)index * SPRITZ_CHANNEL_SLOT_BYTES(_slot_size);
+}
+
+/** begin()
+ * Setup the channel with a key and nonce/salt/iv, And empty it.
+ *
+ * Parameter key:      The key.
+ * Parameter keylen:   Length of the key in bytes.
+ * Parameter nonce:    The nonce (salt), Never reuse it with the same key.
+ * Parameter noncelen: Length of the nonce in bytes.
+ *
+ * Return: Zero (0x00) on success, Non-zero value if the ring has less than 2 slots.
+ */
+uint8_t
+SpritzChannel::begin(const uint8_t *key, uint8_t keyLen,
+                     const uint8_t *nonce, uint8_t nonceLen)
+{
+  uint8_t label;
+
+  if (_slots_count < 2) {
+    return 1; /* A ring of one slot is always full */
+  }
+
+  /* The keystream and the MAC absorb the same key and nonce,
+   * Then a different label, So they are separated states.
+   */
+  label = SPRITZ_CHANNEL_CRYPT_LABEL;
+  spritz_setup_withIV(&_tx_ctx, key, keyLen, nonce, nonceLen);
+  spritz_add_entropy(&_tx_ctx, &label, 1);
+  _rx_ctx = _tx_ctx;
+
+  label = SPRITZ_CHANNEL_MAC_LABEL;
+  spritz_mac_setup(&_tx_mac_ctx, key, keyLen);
+  spritz_mac_update(&_tx_mac_ctx, nonce, nonceLen);
+  spritz_mac_update(&_tx_mac_ctx, &label, 1);
+  _rx_mac_ctx = _tx_mac_ctx;
+
+  _head     = 0;
+  _tail     = 0;
+  _rx_ready = 0;
+  _rx_error = 0;
+
+  return 0;
+}
+
+/** end()
+ * Wipe the states and the slots.
+ */
+void
+SpritzChannel::end()
+{
+  uint8_t i;
+
+  spritz_state_memzero(&_tx_ctx);
+  spritz_state_memzero(&_tx_mac_ctx);
+  spritz_state_memzero(&_rx_ctx);
+  spritz_state_memzero(&_rx_mac_ctx);
+  /* Slot by slot, The whole ring may be more than 65535 bytes */
+  for (i = 0; i < _slots_count; i++) {
+    spritz_memzero(slot(i), SPRITZ_CHANNEL_SLOT_BYTES(_slot_size));
+  }
+
+  _head     = 0;
+  _tail     = 0;
+  _rx_ready = 0;
+}
+
+/** reserve()
+ * Producer, Get the payload of a free slot to write a message in it.
+ *
+ * Return: Pointer to `slotsize` bytes, Or NULL if the ring is full.
+ */
+uint8_t *
+SpritzChannel::reserve()
+{
+  uint8_t next = (uint8_t)(_head + 1);
+
+  if (_slots_count < 2) {
+    return NULL; /* No usable ring, begin() failed */
+  }
+  if (next == _slots_count) {
+    next = 0;
+  }
+  if (next == _tail) {
+    return NULL; /* Full */
+  }
+  return slot(_head) + 1;
+}
+
+/** commit()
+ * Producer, Encrypt the message in the reserved slot and send it.
+ *
+ * Parameter len: Length of the message in bytes (1 to `slotsize`).
+ *
+ * Return: Zero (0x00) if the message is sent,
+ *         Non-zero value if `len` is out of range or the ring is full (Nothing is sent).
+ */
+uint8_t
+SpritzChannel::commit(uint8_t len)
+{
+  uint8_t *s = slot(_head);
+  uint8_t next = (uint8_t)(_head + 1);
+
+  if (next == _slots_count) {
+    next = 0;
+  }
+  if (len == 0 || len > _slot_size || next == _tail || _slots_count < 2) {
+    return 1;
+  }
+
+  s[0] = len;
+  channelCrypt(&_tx_ctx, s + 1, len);
+  spritz_mac_update(&_tx_mac_ctx, s, (uint16_t)(len + 1));
+  spritz_mac_final(&_tx_mac_ctx, s + 1 + len, SPRITZ_CHANNEL_TAG_SIZE);
+
+  SPRITZ_CHANNEL_FENCE();
+  _head = next;
+
+  return 0;
+}
+
+/** receive()
+ * Consumer, Verify and decrypt the oldest message in place.
+ *
+ * Parameter len: Output, Length of the message in bytes.
+ *
+ * Return: Pointer to the message, Or NULL if the ring is empty or on authError().
+ */
+uint8_t *
+SpritzChannel::receive(uint8_t *len)
+{
+  uint8_t tag[SPRITZ_CHANNEL_TAG_SIZE];
+  uint8_t *s;
+
+  if (_rx_error || _tail == _head) {
+    return NULL;
+  }
+  SPRITZ_CHANNEL_FENCE();
+  s = slot(_tail);
+
+  if (!_rx_ready) {
+    if (s[0] == 0 || s[0] > _slot_size) {
+      _rx_error = 1;
+      return NULL;
+    }
+    /* Verify the ciphertext before decrypting it */
+    spritz_mac_update(&_rx_mac_ctx, s, (uint16_t)(s[0] + 1));
+    spritz_mac_final(&_rx_mac_ctx, tag, SPRITZ_CHANNEL_TAG_SIZE);
+    if (spritz_compare(tag, s + 1 + s[0], SPRITZ_CHANNEL_TAG_SIZE)) {
+      _rx_error = 1;
+      return NULL;
+    }
+    channelCrypt(&_rx_ctx, s + 1, s[0]);
+    _rx_ready = 1;
+  }
+
+  *len = s[0];
+  return s + 1;
+}
+
+/** release()
+ * Consumer, Wipe the received message and free its slot.
+ */
+void
+SpritzChannel::release()
+{
+  uint8_t next = (uint8_t)(_tail + 1);
+
+  if (!_rx_ready) {
+    return;
+  }
+  spritz_memzero(slot(_tail), SPRITZ_CHANNEL_SLOT_BYTES(_slot_size));
+  _rx_ready = 0;
+
+  if (next == _slots_count) {
+    next = 0;
+  }
+  SPRITZ_CHANNEL_FENCE();
+  _tail = next;
+}
+
+/** authError()
+ * Return: Non-zero value if a message failed authentication.
+ */
+uint8_t
+SpritzChannel::authError() const
+{
+  return _rx_error;
+}
@@ -0,0 +1,143 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2020 Abderraouf Adjal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#ifndef SPRITZCHANNEL_H
+#define SPRITZCHANNEL_H
+
+#include "SpritzCipher.h"
+
+
+/** SPRITZ_CHANNEL_TAG_SIZE
+ * Length of the authentication tag stored in every slot in bytes.
+ */
+#define SPRITZ_CHANNEL_TAG_SIZE 8
+
+/** SPRITZ_CHANNEL_SLOT_BYTES()
+ * Memory needed for one slot with a payload of `size` bytes,
+ * The slots buffer is `slotscount * SPRITZ_CHANNEL_SLOT_BYTES(slotsize)` bytes.
+ */
+#define SPRITZ_CHANNEL_SLOT_BYTES(size) (1 + (size) + SPRITZ_CHANNEL_TAG_SIZE)
+
+
+/** SpritzChannel
+ * Encrypted single-producer/single-consumer message ring.
+ *
+ * The producer writes a message directly in a slot given by reserve(),
+ * commit() encrypts it in place and appends a tag.
+ * The consumer gets the oldest slot by receive(), It is verified then
+ * decrypted in place, And release() wipes it and frees it.
+ * No message is copied, And the slots memory never holds a plaintext
+ * between commit() and receive().
+ *
+ * The producer and the consumer may be an interrupt and the main loop,
+ * Or two tasks. The ring indices are bytes, Each written by one side only.
+ * There is no blocking, The consumer polls receive().
+ * With SPRITZ_STATS, Only begin() is recorded (Its setup), So call it out of interrupts.
+ *
+ * Each side has a spritz_ctx for the keystream and one for the MAC (Encrypt-then-MAC),
+ * Both from the key and nonce with a different label.
+ * Each tag authenticates its message and all the messages before it.
+ * The ring needs 2 slots or more, One slot is always kept free.
+ */
+class SpritzChannel
+{
+  public:
+    SpritzChannel(uint8_t *slots, uint8_t slotsCount, uint8_t slotSize);
+
+    /** begin()
+     * Setup the channel with a key and nonce/salt/iv, And empty it.
+     *
+     * Parameter key:      The key.
+     * Parameter keylen:   Length of the key in bytes.
+     * Parameter nonce:    The nonce (salt), Never reuse it with the same key.
+     * Parameter noncelen: Length of the nonce in bytes.
+     *
+     * Return: Zero (0x00) on success, Non-zero value if the ring has less than 2 slots
+     *         (Then reserve() returns NULL and commit() fails).
+     */
+    uint8_t begin(const uint8_t *key, uint8_t keyLen,
+               const uint8_t *nonce, uint8_t nonceLen);
+
+    /** end()
+     * Wipe the states and the slots.
+     */
+    void end();
+
+    /** reserve()
+     * Producer, Get the payload of a free slot to write a message in it.
+     *
+     * Return: Pointer to `slotsize` bytes, Or NULL if the ring is full.
+     */
+    uint8_t *reserve();
+
+    /** commit()
+     * Producer, Encrypt the message in the reserved slot and send it.
+     *
+     * Parameter len: Length of the message in bytes (1 to `slotsize`).
+     *
+     * Return: Zero (0x00) if the message is sent,
+     *         Non-zero value if `len` is out of range or the ring is full (Nothing is sent).
+     */
+    uint8_t commit(uint8_t len);
+
+    /** receive()
+     * Consumer, Verify and decrypt the oldest message in place.
+     *
+     * Parameter len: Output, Length of the message in bytes.
+     *
+     * Return: Pointer to the message, Or NULL if the ring is empty or on authError().
+     */
+    uint8_t *receive(uint8_t *len);
+
+    /** release()
+     * Consumer, Wipe the received message and free its slot.
+     */
+    void release();
+
+    /** authError()
+     * Return: Non-zero value if a message failed authentication.
+     *         After that receive() returns NULL until begin() is called again.
+     */
+    uint8_t authError() const;
+
+  private:
+    uint8_t *slot(uint8_t index) const;
+
+    uint8_t *_slots;
+    uint8_t _slots_count;
+    uint8_t _slot_size;
+
+    volatile uint8_t _head; /* Next slot to commit, Written by the producer */
+    volatile uint8_t _tail; /* Next slot to receive, Written by the consumer */
+
+    spritz_ctx _tx_ctx, _tx_mac_ctx;
+    spritz_ctx _rx_ctx, _rx_mac_ctx;
+    uint8_t _rx_ready; /* Non-zero if the slot at `_tail` is decrypted */
+    uint8_t _rx_error;
+};
+
+
+#endif /* SpritzChannel.h */
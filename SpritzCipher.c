@@ -29,6 +29,63 @@
 #define SPRITZ_N_MINUS_1 255 /* SPRITZ_N - 1 */
 #define SPRITZ_N_HALF 128 /* SPRITZ_N / 2 */
 
+/* On CPUs with fast unaligned stores, spritz_state_init() writes the identity
+ * permutation a word at a time, SPRITZ_WORD_INIT is the first word {0, 1, 2, 3}.
+ * `spritz_ctx` has no alignment, So others (AVR, Cortex-M0, ESP8266 Xtensa, ...)
+ * keep the byte loop.
+ */
+#if defined(__BYTE_ORDER__) \
+    && (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__) \
+        || (defined(__arm__) && defined(__ARM_FEATURE_UNALIGNED)))
+# if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define SPRITZ_WORD_INIT 0x03020100
+# elif __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#  define SPRITZ_WORD_INIT 0x00010203
+# endif
+#endif
+
+#ifdef SPRITZ_WORD_INIT
+# include <string.h> /* memcpy() */
+#endif
+
+#ifdef SPRITZ_STATS
+# ifdef ARDUINO
+#  include <Arduino.h> /* micros() */
+# endif
+
+/* The recorded latency histograms */
+static spritz_stats statsData;
+
+/* Add a latency of `ticks` to the histogram of the operation `op` */
+static void
+statsRecord(uint8_t op, uint32_t ticks)
+{
+  spritz_stats_hist *hist = &statsData.op[op];
+  uint8_t b = 0;
+
+  while (b < (SPRITZ_STATS_BUCKETS - 1) && (ticks >> b)) {
+    b++;
+  }
+  if (!hist->count || ticks < hist->min) {
+    hist->min = ticks;
+  }
+  if (ticks > hist->max) {
+    hist->max = ticks;
+  }
+  hist->count++;
+  hist->buckets[b]++;
+}
+
+/* SPRITZ_STATS_START after the declarations of a function,
+ * Then SPRITZ_STATS_STOP(op) at its end.
+ */
+# define SPRITZ_STATS_START uint32_t stats_start_ = (uint32_t)SPRITZ_STATS_CLOCK()
+# define SPRITZ_STATS_STOP(op) statsRecord((op), (uint32_t)SPRITZ_STATS_CLOCK() - stats_start_)
+#else
+# define SPRITZ_STATS_START
+# define SPRITZ_STATS_STOP(op)
+#endif
+
 
 static void
 spritz_state_s_swap(spritz_ctx *ctx, uint8_t index_a, uint8_t index_b)
@@ -48,12 +105,23 @@ spritz_state_s_swap(spritz_ctx *ctx, uint8_t index_a, uint8_t index_b)
 static void
 spritz_state_init(spritz_ctx *ctx)
 {
+#ifdef SPRITZ_WORD_INIT
+  uint32_t w = SPRITZ_WORD_INIT;
+  uint16_t i;
+
+  /* Four bytes of the identity permutation per store, Bytes never carry */
+  for (i = 0; i < SPRITZ_N; i += 4) {
+    memcpy(ctx->s + i, &w, 4);
+    w += 0x04040404;
+  }
+#else
   uint8_t i = 0;
 
   /* Loop for SPRITZ_N=256 */
   do {
     ctx->s[i] = i;
   } while (++i);
+#endif /* SPRITZ_WORD_INIT */
 
   ctx->i = 0;
   ctx->j = 0;
@@ -75,6 +143,7 @@ update(spritz_ctx *ctx)
 static void
 whip(spritz_ctx *ctx)
 {
+#ifdef SPRITZ_WIPE_TRACES_PARANOID
   uint8_t i;
 
   for (i = 0; i < SPRITZ_N_HALF; i++) {
@@ -83,6 +152,26 @@ whip(spritz_ctx *ctx)
     update(ctx);
     update(ctx);
   }
+#else
+  /* update() with the registers in local variables, So they are not
+   * reloaded after every write to `s` (uint8_t may alias the registers).
+   */
+  uint8_t *s = ctx->s, i = ctx->i, j = ctx->j, k = ctx->k, w = ctx->w, t;
+  uint16_t n;
+
+  for (n = 0; n < SPRITZ_N * 2; n++) {
+    i = (uint8_t)(i + w);
+    j = (uint8_t)(s[(uint8_t)(s[i] + j)] + k);
+    k = (uint8_t)(s[j] + k + i);
+    t = s[i];
+    s[i] = s[j];
+    s[j] = t;
+  }
+
+  ctx->i = i;
+  ctx->j = j;
+  ctx->k = k;
+#endif /* SPRITZ_WIPE_TRACES_PARANOID */
 
   ctx->w = (uint8_t)(ctx->w + 2);
 }
@@ -170,9 +259,9 @@ absorb(spritz_ctx *ctx, const uint8_t octet)
   absorbNibble(ctx, octet / 16); /* With the Left/High nibble */
 }
 static void
-absorbBytes(spritz_ctx *ctx, const uint8_t *buf, uint16_t len)
+absorbBytes(spritz_ctx *ctx, const uint8_t *buf, size_t len)
 {
-  uint16_t i;
+  size_t i;
 
   for (i = 0; i < len; i++) {
     absorb(ctx, buf[i]);
@@ -206,6 +295,21 @@ drip(spritz_ctx *ctx)
   return output(ctx);
 }
 
+/* drip() `len` times, The shuffle check is done once for the whole block */
+static void
+squeeze(spritz_ctx *ctx, uint8_t *buf, uint16_t len)
+{
+  uint16_t i;
+
+  if (ctx->a) {
+    shuffle(ctx);
+  }
+  for (i = 0; i < len; i++) {
+    update(ctx);
+    buf[i] = output(ctx);
+  }
+}
+
 
 /* |====================|| User Functions ||====================| */
 
@@ -325,11 +429,7 @@ void
 spritz_setup(spritz_ctx *ctx,
              const uint8_t *key, uint8_t keyLen)
 {
-  spritz_state_init(ctx);
-  absorbBytes(ctx, key, keyLen);
-  if (ctx->a) {
-    shuffle(ctx);
-  }
+  spritz_setup_long(ctx, key, keyLen); /* Recorded by it */
 }
 
 /** spritz_setup_withiv()
@@ -346,6 +446,48 @@ spritz_setup_withIV(spritz_ctx *ctx,
                     const uint8_t *key, uint8_t keyLen,
                     const uint8_t *nonce, uint8_t nonceLen)
 {
+  spritz_setup_withIV_long(ctx, key, keyLen, nonce, nonceLen); /* Recorded by it */
+}
+
+/** spritz_setup_long()
+ * Setup the spritz state `spritz_ctx` with a key of any length.
+ * Same as spritz_setup() for keys shorter than 256 bytes.
+ *
+ * Parameter ctx:    The context.
+ * Parameter key:    The key.
+ * Parameter keylen: Length of the key in bytes.
+ */
+void
+spritz_setup_long(spritz_ctx *ctx,
+                  const uint8_t *key, size_t keyLen)
+{
+  SPRITZ_STATS_START;
+
+  spritz_state_init(ctx);
+  absorbBytes(ctx, key, keyLen);
+  if (ctx->a) {
+    shuffle(ctx);
+  }
+  SPRITZ_STATS_STOP(SPRITZ_STATS_SETUP);
+}
+
+/** spritz_setup_withIV_long()
+ * Setup the spritz state `spritz_ctx` with a key and nonce/salt/iv of any length.
+ * Same as spritz_setup_withIV() for keys and nonces shorter than 256 bytes.
+ *
+ * Parameter ctx:      The context.
+ * Parameter key:      The key.
+ * Parameter keylen:   Length of the key in bytes.
+ * Parameter nonce:    The nonce (salt).
+ * Parameter noncelen: Length of the nonce in bytes.
+ */
+void
+spritz_setup_withIV_long(spritz_ctx *ctx,
+                         const uint8_t *key, size_t keyLen,
+                         const uint8_t *nonce, size_t nonceLen)
+{
+  SPRITZ_STATS_START;
+
   spritz_state_init(ctx);
   absorbBytes(ctx, key, keyLen);
   absorbStop(ctx);
@@ -353,6 +495,59 @@ spritz_setup_withIV(spritz_ctx *ctx,
   if (ctx->a) {
     shuffle(ctx);
   }
+  SPRITZ_STATS_STOP(SPRITZ_STATS_SETUP);
+}
+
+/** spritz_key_setup()
+ * Absorb a key in `key_ctx` only, To be used as a cached keyed state by
+ * spritz_setup_withIV_fromKey() for many nonces.
+ *
+ * Parameter key_ctx: The keyed state.
+ * Parameter key:     The key.
+ * Parameter keylen:  Length of the key in bytes.
+ */
+void
+spritz_key_setup(spritz_ctx *key_ctx,
+                 const uint8_t *key, uint8_t keyLen)
+{
+  SPRITZ_STATS_START;
+
+  spritz_state_init(key_ctx);
+  absorbBytes(key_ctx, key, keyLen);
+  absorbStop(key_ctx);
+  SPRITZ_STATS_STOP(SPRITZ_STATS_SETUP);
+}
+
+/* spritz_setup_withIV_fromKey() without SPRITZ_STATS recording, For the packets functions */
+static void
+setupFromKey(spritz_ctx *ctx, const spritz_ctx *key_ctx,
+             const uint8_t *nonce, uint8_t nonceLen)
+{
+  *ctx = *key_ctx;
+  absorbBytes(ctx, nonce, nonceLen);
+  if (ctx->a) {
+    shuffle(ctx);
+  }
+}
+
+/** spritz_setup_withIV_fromKey()
+ * Setup the spritz state `spritz_ctx` with a cached keyed state and nonce/salt/iv.
+ * The result is the same as spritz_setup_withIV() with the key of `key_ctx`,
+ * Without absorbing the key again.
+ *
+ * Parameter ctx:      The context.
+ * Parameter key_ctx:  The keyed state from spritz_key_setup().
+ * Parameter nonce:    The nonce (salt).
+ * Parameter noncelen: Length of the nonce in bytes.
+ */
+void
+spritz_setup_withIV_fromKey(spritz_ctx *ctx, const spritz_ctx *key_ctx,
+                            const uint8_t *nonce, uint8_t nonceLen)
+{
+  SPRITZ_STATS_START;
+
+  setupFromKey(ctx, key_ctx, nonce, nonceLen);
+  SPRITZ_STATS_STOP(SPRITZ_STATS_SETUP);
 }
 
 /** spritz_random8()
@@ -369,6 +564,22 @@ spritz_random8(spritz_ctx *ctx)
   return drip(ctx);
 }
 
+/** spritz_random_bytes()
+ * Generates `len` random bytes from the spritz state `spritz_ctx` in one block.
+ * The output is the same as calling spritz_random8() `len` times, But faster.
+ * Usable only after calling spritz_setup() or spritz_setup_withiv().
+ *
+ * Parameter ctx: The context.
+ * Parameter buf: The output.
+ * Parameter len: Length of the output in bytes.
+ */
+void
+spritz_random_bytes(spritz_ctx *ctx,
+                    uint8_t *buf, uint16_t len)
+{
+  squeeze(ctx, buf, len);
+}
+
 /** spritz_random32()
  * Generates a random 32-bit (4 bytes) from the spritz state `spritz_ctx`.
  * Usable only after calling spritz_setup() or spritz_setup_withiv().
@@ -380,11 +591,20 @@ spritz_random8(spritz_ctx *ctx)
 uint32_t
 spritz_random32(spritz_ctx *ctx)
 {
-  return (uint32_t)(
-      ((uint32_t)(spritz_random8(ctx)) <<  0)
-    | ((uint32_t)(spritz_random8(ctx)) <<  8)
-    | ((uint32_t)(spritz_random8(ctx)) << 16)
-    | ((uint32_t)(spritz_random8(ctx)) << 24));
+  uint8_t b[4];
+  uint32_t r;
+
+  squeeze(ctx, b, 4);
+  r = (uint32_t)(
+      ((uint32_t)(b[0]) <<  0)
+    | ((uint32_t)(b[1]) <<  8)
+    | ((uint32_t)(b[2]) << 16)
+    | ((uint32_t)(b[3]) << 24));
+
+#ifdef SPRITZ_WIPE_TRACES_PARANOID
+  spritz_memzero(b, 4);
+#endif
+  return r;
 }
 
 /** spritz_random32_uniform()
@@ -431,6 +651,60 @@ spritz_random32_uniform(spritz_ctx *ctx, uint32_t upper_bound)
   }
 }
 
+/* Random bytes made at a time by spritz_shuffle() */
+#define SPRITZ_SHUFFLE_BATCH 32
+
+/** spritz_shuffle()
+ * Shuffle an array of `count` records of `size` bytes each in place (Fisher-Yates).
+ * The random indices are taken from batches of SPRITZ_SHUFFLE_BATCH bytes made by squeeze(),
+ * One byte for an index below 256 else two bytes, Without modulo bias
+ * (Like spritz_random32_uniform(), A number below `2**bits % bound` is taken again).
+ * Every order is equally likely, And the same state gives the same order.
+ * Usable only after calling spritz_setup() or spritz_setup_withiv().
+ *
+ * Parameter ctx:   The context.
+ * Parameter base:  The records.
+ * Parameter count: Number of the records.
+ * Parameter size:  Length of a record in bytes.
+ */
+void
+spritz_shuffle(spritz_ctx *ctx,
+               uint8_t *base, uint16_t count, uint16_t size)
+{
+  uint8_t r[SPRITZ_SHUFFLE_BATCH];
+  uint8_t pos = SPRITZ_SHUFFLE_BATCH; /* Empty batch */
+  uint8_t *a, *b, t;
+  uint16_t i, n, min;
+  uint32_t bound, j;
+
+  for (i = (uint16_t)(count - 1); count > 1 && i > 0; i--) {
+    bound = (uint32_t)i + 1;
+    min   = (uint16_t)((bound > 256) ? (0x10000UL % bound) : (0x100UL % bound));
+    do {
+      if (pos > (SPRITZ_SHUFFLE_BATCH - 2)) {
+        squeeze(ctx, r, SPRITZ_SHUFFLE_BATCH);
+        pos = 0;
+      }
+      j = r[pos++];
+      if (bound > 256) {
+        j |= (uint32_t)r[pos++] << 8;
+      }
+    } while (j < min);
+
+    a = base + (uint32_t)i * size;
+    b = base + (j % bound) * size;
+    for (n = 0; n < size; n++) {
+      t    = a[n];
+      a[n] = b[n];
+      b[n] = t;
+    }
+  }
+
+#ifdef SPRITZ_WIPE_TRACES_PARANOID
+  spritz_memzero(r, SPRITZ_SHUFFLE_BATCH);
+#endif
+}
+
 /** spritz_add_entropy()
  * Add entropy to the spritz state `spritz_ctx` using absorb().
  * Usable only after calling spritz_setup() or spritz_setup_withiv().
@@ -446,6 +720,25 @@ spritz_add_entropy(spritz_ctx *ctx,
   absorbBytes(ctx, entropy, len);
 }
 
+/* spritz_crypt() without SPRITZ_STATS recording,
+ * For the functions that record a call once (Not for each part).
+ */
+static void
+cryptBytes(spritz_ctx *ctx,
+           const uint8_t *data, uint16_t dataLen,
+           uint8_t *dataOut)
+{
+  uint16_t i;
+
+  if (ctx->a) {
+    shuffle(ctx);
+  }
+  for (i = 0; i < dataLen; i++) {
+    update(ctx);
+    dataOut[i] = data[i] ^ output(ctx);
+  }
+}
+
 /** spritz_crypt()
  * Encrypt or decrypt data chunk by XOR-ing it with the spritz keystream.
  * Usable only after calling spritz_setup() or spritz_setup_withiv().
@@ -459,11 +752,422 @@ void
 spritz_crypt(spritz_ctx *ctx,
              const uint8_t *data, uint16_t dataLen,
              uint8_t *dataOut)
+{
+  SPRITZ_STATS_START;
+
+  cryptBytes(ctx, data, dataLen, dataOut);
+  SPRITZ_STATS_STOP(SPRITZ_STATS_CRYPT);
+}
+
+
+#ifndef SPRITZ_WIPE_TRACES_PARANOID
+/* One keystream byte of an interleaved lane, Same as update() then output().
+ * The registers are local variables, So the compiler can keep them in CPU registers
+ * and the loads of the lanes overlap.
+ */
+# define SPRITZ_LANE_CRYPT(s, i, j, k, z, w, in, out) \
+  do { \
+    uint8_t t_; \
+    i = (uint8_t)(i + w); \
+    j = (uint8_t)(s[(uint8_t)(s[i] + j)] + k); \
+    k = (uint8_t)(s[j] + k + i); \
+    t_ = s[i]; s[i] = s[j]; s[j] = t_; \
+    z = s[(uint8_t)(s[(uint8_t)(s[(uint8_t)(z + k)] + i)] + j)]; \
+    (out) = (uint8_t)((in) ^ z); \
+  } while (0)
+
+# define SPRITZ_LANE_LOAD(c, S, I, J, K, Z, W) \
+  do { \
+    if ((c)->a) { \
+      shuffle(c); \
+    } \
+    S = (c)->s; I = (c)->i; J = (c)->j; K = (c)->k; Z = (c)->z; W = (c)->w; \
+  } while (0)
+
+# define SPRITZ_LANE_STORE(c, I, J, K, Z) \
+  do { \
+    (c)->i = I; (c)->j = J; (c)->k = K; (c)->z = Z; \
+  } while (0)
+
+static void
+crypt2(spritz_ctx *const *ctx,
+       const uint8_t *const *data, uint16_t dataLen,
+       uint8_t *const *dataOut)
+{
+  uint8_t *s0, i0, j0, k0, z0, w0;
+  uint8_t *s1, i1, j1, k1, z1, w1;
+  uint16_t n;
+
+  SPRITZ_LANE_LOAD(ctx[0], s0, i0, j0, k0, z0, w0);
+  SPRITZ_LANE_LOAD(ctx[1], s1, i1, j1, k1, z1, w1);
+  for (n = 0; n < dataLen; n++) {
+    SPRITZ_LANE_CRYPT(s0, i0, j0, k0, z0, w0, data[0][n], dataOut[0][n]);
+    SPRITZ_LANE_CRYPT(s1, i1, j1, k1, z1, w1, data[1][n], dataOut[1][n]);
+  }
+  SPRITZ_LANE_STORE(ctx[0], i0, j0, k0, z0);
+  SPRITZ_LANE_STORE(ctx[1], i1, j1, k1, z1);
+}
+
+static void
+crypt4(spritz_ctx *const *ctx,
+       const uint8_t *const *data, uint16_t dataLen,
+       uint8_t *const *dataOut)
+{
+  uint8_t *s0, i0, j0, k0, z0, w0;
+  uint8_t *s1, i1, j1, k1, z1, w1;
+  uint8_t *s2, i2, j2, k2, z2, w2;
+  uint8_t *s3, i3, j3, k3, z3, w3;
+  uint16_t n;
+
+  SPRITZ_LANE_LOAD(ctx[0], s0, i0, j0, k0, z0, w0);
+  SPRITZ_LANE_LOAD(ctx[1], s1, i1, j1, k1, z1, w1);
+  SPRITZ_LANE_LOAD(ctx[2], s2, i2, j2, k2, z2, w2);
+  SPRITZ_LANE_LOAD(ctx[3], s3, i3, j3, k3, z3, w3);
+  for (n = 0; n < dataLen; n++) {
+    SPRITZ_LANE_CRYPT(s0, i0, j0, k0, z0, w0, data[0][n], dataOut[0][n]);
+    SPRITZ_LANE_CRYPT(s1, i1, j1, k1, z1, w1, data[1][n], dataOut[1][n]);
+    SPRITZ_LANE_CRYPT(s2, i2, j2, k2, z2, w2, data[2][n], dataOut[2][n]);
+    SPRITZ_LANE_CRYPT(s3, i3, j3, k3, z3, w3, data[3][n], dataOut[3][n]);
+  }
+  SPRITZ_LANE_STORE(ctx[0], i0, j0, k0, z0);
+  SPRITZ_LANE_STORE(ctx[1], i1, j1, k1, z1);
+  SPRITZ_LANE_STORE(ctx[2], i2, j2, k2, z2);
+  SPRITZ_LANE_STORE(ctx[3], i3, j3, k3, z3);
+}
+#endif /* SPRITZ_WIPE_TRACES_PARANOID */
+
+/* spritz_crypt_interleaved() without SPRITZ_STATS recording, For the packets functions */
+static void
+cryptInterleaved(spritz_ctx *const *ctx, uint8_t ctxCount,
+                 const uint8_t *const *data, uint16_t dataLen,
+                 uint8_t *const *dataOut)
+{
+  uint8_t n = 0;
+
+#ifndef SPRITZ_WIPE_TRACES_PARANOID
+  /* Paranoid mode keeps the state out of local variables, So it is not interleaved */
+  for (; ctxCount - n >= 4; n = (uint8_t)(n + 4)) {
+    crypt4(ctx + n, data + n, dataLen, dataOut + n);
+  }
+  if (ctxCount - n >= 2) {
+    crypt2(ctx + n, data + n, dataLen, dataOut + n);
+    n = (uint8_t)(n + 2);
+  }
+#endif
+  for (; n < ctxCount; n++) {
+    cryptBytes(ctx[n], data[n], dataLen, dataOut[n]);
+  }
+}
+
+/** spritz_crypt_interleaved()
+ * Encrypt or decrypt data chunks of independent contexts in one loop.
+ * The output is the same as calling spritz_crypt() for each context,
+ * But the dependent loads of the contexts overlap, That is faster on CPUs
+ * that can execute more than one instruction at a time.
+ * The contexts are processed four (or two) at a time, As `ctxcount` allows.
+ * Usable only after calling spritz_setup() or spritz_setup_withiv() for each context.
+ *
+ * Parameter ctx:      The contexts, They MUST be different contexts.
+ * Parameter ctxcount: Number of the contexts.
+ * Parameter data:     The data chunk of each context.
+ * Parameter datalen:  Length of each data chunk in bytes.
+ * Parameter dataout:  The output of each context.
+ */
+void
+spritz_crypt_interleaved(spritz_ctx *const *ctx, uint8_t ctxCount,
+                         const uint8_t *const *data, uint16_t dataLen,
+                         uint8_t *const *dataOut)
+{
+  SPRITZ_STATS_START;
+
+  cryptInterleaved(ctx, ctxCount, data, dataLen, dataOut);
+  SPRITZ_STATS_STOP(SPRITZ_STATS_CRYPT); /* One record for all the contexts */
+}
+
+
+/* The longest tag of spritz_seal_packets() and spritz_open_packets(), Longer is cut to it */
+#define SPRITZ_PACKET_TAG_MAX 32
+
+/* Crypt `count` packets with `scratch` contexts, `scratchcount` packets at a time.
+ * The common length of a group is crypted interleaved, The rest of each packet alone.
+ */
+static void
+cryptPackets(const spritz_ctx *key_ctx, spritz_packet *packets, uint8_t count,
+             spritz_ctx *scratch, uint8_t scratchCount)
+{
+  spritz_ctx *ctx[4];
+  const uint8_t *data[4];
+  uint8_t *dataOut[4];
+  uint16_t minLen;
+  uint8_t n, lanes, l;
+
+  if (scratchCount > 4) {
+    scratchCount = 4;
+  }
+  else if (!scratchCount) {
+    return; /* No lanes, Never loop forever */
+  }
+  for (n = 0; n < count; n = (uint8_t)(n + lanes)) {
+    lanes  = (uint8_t)((count - n < scratchCount) ? (count - n) : scratchCount);
+    minLen = packets[n].len;
+    for (l = 0; l < lanes; l++) {
+      setupFromKey(&scratch[l], key_ctx, packets[n + l].nonce, packets[n + l].nonceLen);
+      ctx[l]     = &scratch[l];
+      data[l]    = packets[n + l].data;
+      dataOut[l] = packets[n + l].data;
+      if (packets[n + l].len < minLen) {
+        minLen = packets[n + l].len;
+      }
+    }
+    cryptInterleaved(ctx, lanes, data, minLen, dataOut);
+    for (l = 0; l < lanes; l++) {
+      cryptBytes(&scratch[l], packets[n + l].data + minLen,
+                 (uint16_t)(packets[n + l].len - minLen), packets[n + l].data + minLen);
+    }
+  }
+}
+
+/* The tag of a packet: MAC(nonce || ciphertext) */
+static void
+packetTag(const spritz_ctx *mac_key_ctx, const spritz_packet *packet,
+          uint8_t *tag, uint8_t tagLen, spritz_ctx *scratch)
+{
+  *scratch = *mac_key_ctx;
+  spritz_mac_update(scratch, packet->nonce, packet->nonceLen);
+  absorbStop(scratch);
+  spritz_mac_update(scratch, packet->data, packet->len);
+  spritz_mac_final(scratch, tag, tagLen);
+}
+
+/** spritz_seal_packets()
+ * Encrypt a burst of packets in place and compute their tags (Encrypt-then-MAC).
+ * The keystream of a packet is from spritz_setup_withIV_fromKey() with the packet nonce,
+ * Its tag is the MAC of its nonce and ciphertext from the cached MAC state `mac_key_ctx`.
+ * The packets are encrypted `scratchcount` at a time by spritz_crypt_interleaved().
+ *
+ * Parameter key_ctx:      The keyed state from spritz_key_setup().
+ * Parameter mac_key_ctx:  The MAC state from spritz_mac_setup() (Use a different key).
+ * Parameter packets:      The packets, Never reuse a nonce with the same key.
+ * Parameter packetscount: Number of the packets.
+ * Parameter taglen:       Length of a tag in bytes (1 to 32), If zero nothing is done.
+ * Parameter scratch:      Work contexts, They are wiped before returning.
+ * Parameter scratchcount: Number of the work contexts (One or more).
+ */
+void
+spritz_seal_packets(const spritz_ctx *key_ctx, const spritz_ctx *mac_key_ctx,
+                    spritz_packet *packets, uint8_t packetsCount, uint8_t tagLen,
+                    spritz_ctx *scratch, uint8_t scratchCount)
+{
+  uint8_t n;
+  SPRITZ_STATS_START;
+
+  if (!scratchCount || !tagLen) {
+    return; /* No work context, Or no tag to authenticate the packets */
+  }
+  if (tagLen > SPRITZ_PACKET_TAG_MAX) {
+    tagLen = SPRITZ_PACKET_TAG_MAX; /* Same as spritz_open_packets() */
+  }
+  cryptPackets(key_ctx, packets, packetsCount, scratch, scratchCount);
+  for (n = 0; n < packetsCount; n++) {
+    packetTag(mac_key_ctx, &packets[n], packets[n].tag, tagLen, scratch);
+  }
+
+  for (n = 0; n < scratchCount; n++) {
+    spritz_state_memzero(&scratch[n]);
+  }
+  SPRITZ_STATS_STOP(SPRITZ_STATS_PACKETS); /* Not CRYPT, The burst has setups and tags too */
+}
+
+/** spritz_open_packets()
+ * Verify a burst of packets from spritz_seal_packets(), Then decrypt the authentic ones in place.
+ * The `len` of a packet that failed authentication is set to zero, And its data is not decrypted.
+ *
+ * Parameters: Like spritz_seal_packets().
+ *
+ * Return: Number of the authentic packets, Zero if `taglen` is zero (Every `len` is set to zero).
+ */
+uint8_t
+spritz_open_packets(const spritz_ctx *key_ctx, const spritz_ctx *mac_key_ctx,
+                    spritz_packet *packets, uint8_t packetsCount, uint8_t tagLen,
+                    spritz_ctx *scratch, uint8_t scratchCount)
+{
+  uint8_t tag[SPRITZ_PACKET_TAG_MAX];
+  uint8_t n, authentic = 0;
+  SPRITZ_STATS_START;
+
+  if (!scratchCount) {
+    return 0; /* No work context */
+  }
+  if (!tagLen) {
+    /* An empty tag matches any packet, So no packet is authentic */
+    for (n = 0; n < packetsCount; n++) {
+      packets[n].len = 0;
+    }
+    return 0;
+  }
+  if (tagLen > SPRITZ_PACKET_TAG_MAX) {
+    tagLen = SPRITZ_PACKET_TAG_MAX; /* Same as spritz_seal_packets() */
+  }
+  for (n = 0; n < packetsCount; n++) {
+    packetTag(mac_key_ctx, &packets[n], tag, tagLen, scratch);
+    if (spritz_compare(tag, packets[n].tag, tagLen)) {
+      packets[n].len = 0; /* Forged, Crypt nothing */
+    }
+    else {
+      authentic++;
+    }
+  }
+  cryptPackets(key_ctx, packets, packetsCount, scratch, scratchCount);
+
+  for (n = 0; n < scratchCount; n++) {
+    spritz_state_memzero(&scratch[n]);
+  }
+#ifdef SPRITZ_WIPE_TRACES_PARANOID
+  spritz_memzero(tag, (uint16_t)(sizeof(tag)));
+#endif
+  SPRITZ_STATS_STOP(SPRITZ_STATS_PACKETS); /* Not CRYPT, The burst has setups and tags too */
+  return authentic;
+}
+
+/** spritz_nonce_setup()
+ * Setup the nonces allocator from the stored high-water mark.
+ * No reserved counter is persisted yet, So the first allocation persists a new mark.
+ *
+ * Parameter nonce_ctx:     The nonces allocator.
+ * Parameter highwatermark: The last persisted high-water mark (0 the first time).
+ * Parameter step:          Number of the counters reserved by a write (One or more).
+ * Parameter persist:       The function that stores a high-water mark, Returns zero on success.
+ */
+void
+spritz_nonce_setup(spritz_nonce_ctx *nonce_ctx, uint32_t highWaterMark, uint32_t step,
+                   uint8_t (*persist)(uint32_t highWaterMark))
+{
+  /* Counters below the mark may have been given before the reset */
+  nonce_ctx->next     = highWaterMark;
+  nonce_ctx->reserved = highWaterMark;
+  nonce_ctx->step     = step ? step : 1;
+  nonce_ctx->persist  = persist;
+  /* The last mark, The counter 0xffffffff may have been given */
+  nonce_ctx->exhausted = (uint8_t)(highWaterMark == 0xffffffff);
+}
+
+/** spritz_nonce_range()
+ * Allocate `count` consecutive counters, That are never given again even after a reset.
+ * The high-water mark is persisted only when the reserved counters are used up.
+ *
+ * Parameter nonce_ctx: The nonces allocator.
+ * Parameter count:     Number of the counters.
+ * Parameter first:     Output, The first counter of the range.
+ *
+ * Return: Zero on success, Non-zero value if the counters are exhausted
+ *         (Change the key) or the high-water mark can not be persisted.
+ */
+uint8_t
+spritz_nonce_range(spritz_nonce_ctx *nonce_ctx, uint32_t count, uint32_t *first)
+{
+  uint32_t end, mark;
+  uint8_t last;
+
+  /* Up to 2^32 - `next` counters are left, All of them if `next` is zero */
+  if (nonce_ctx->exhausted || (nonce_ctx->next && count > (uint32_t)(0 - nonce_ctx->next))) {
+    return 1; /* Exhausted */
+  }
+  end  = nonce_ctx->next + count; /* Zero if the range ends at 2^32 */
+  last = (uint8_t)(count && !end); /* The range has the counter 0xffffffff */
+
+  if (last ? (nonce_ctx->reserved != 0xffffffff) : (end > nonce_ctx->reserved)) {
+    /* Reserve ahead, The mark is persisted before any counter above the old mark is given */
+    mark = end + nonce_ctx->step;
+    if (last || mark < end) {
+      mark = 0xffffffff; /* The last reservation */
+    }
+    if (nonce_ctx->persist(mark)) {
+      return 2;
+    }
+    nonce_ctx->reserved = mark;
+  }
+
+  *first = nonce_ctx->next;
+  nonce_ctx->next = end;
+  nonce_ctx->exhausted = last;
+  return 0;
+}
+
+/** spritz_nonce_next()
+ * Allocate one counter as a 4 bytes nonce (Little-endian) for spritz_setup_withIV().
+ *
+ * Parameter nonce_ctx: The nonces allocator.
+ * Parameter nonce:     Output, The nonce (4 bytes).
+ *
+ * Return: Zero on success, Non-zero value like spritz_nonce_range().
+ */
+uint8_t
+spritz_nonce_next(spritz_nonce_ctx *nonce_ctx, uint8_t *nonce)
+{
+  uint32_t counter;
+  uint8_t ret;
+
+  ret = spritz_nonce_range(nonce_ctx, 1, &counter);
+  if (!ret) {
+    nonce[0] = (uint8_t)(counter);
+    nonce[1] = (uint8_t)(counter >> 8);
+    nonce[2] = (uint8_t)(counter >> 16);
+    nonce[3] = (uint8_t)(counter >> 24);
+  }
+  return ret;
+}
+
+/** spritz_pool_setup()
+ * Setup the random bytes pool `spritz_pool` with a seed, Then fill it.
+ *
+ * Parameter pool:    The pool.
+ * Parameter seed:    The seed (entropy).
+ * Parameter seedlen: Length of the seed in bytes.
+ */
+void
+spritz_pool_setup(spritz_pool *pool,
+                  const uint8_t *seed, uint8_t seedLen)
+{
+  spritz_setup(&pool->ctx, seed, seedLen);
+  pool->pos = SPRITZ_POOL_SIZE; /* All bytes are used */
+  spritz_pool_refill(pool);
+}
+
+/** spritz_pool_refill()
+ * Generate the used bytes of the pool in one block.
+ * Call it when the program is idle, So spritz_pool_random() will only copy bytes.
+ *
+ * Parameter pool: The pool.
+ */
+void
+spritz_pool_refill(spritz_pool *pool)
+{
+  if (pool->pos) {
+    squeeze(&pool->ctx, pool->buf, pool->pos);
+    pool->pos = 0;
+  }
+}
+
+/** spritz_pool_random()
+ * Get random bytes from the pool, The given bytes are wiped from the pool.
+ * The pool is refilled when it is empty.
+ *
+ * Parameter pool: The pool.
+ * Parameter buf:  The output.
+ * Parameter len:  Length of the output in bytes.
+ */
+void
+spritz_pool_random(spritz_pool *pool,
+                   uint8_t *buf, uint16_t len)
 {
   uint16_t i;
 
-  for (i = 0; i < dataLen; i++) {
-    dataOut[i] = data[i] ^ drip(ctx);
+  for (i = 0; i < len; i++) {
+    if (pool->pos == SPRITZ_POOL_SIZE) {
+      spritz_pool_refill(pool);
+    }
+    buf[i] = pool->buf[pool->pos];
+    pool->buf[pool->pos++] = 0;
   }
 }
 
@@ -479,6 +1183,23 @@ spritz_hash_setup(spritz_ctx *hash_ctx)
   spritz_state_init(hash_ctx);
 }
 
+/** spritz_hash_reset()
+ * Reset a used hash context `spritz_ctx` for a new hash.
+ * The previous state is overwritten by the setup in one pass,
+ * Use it instead of spritz_state_memzero() then spritz_hash_setup().
+ *
+ * Parameter hash_ctx: The hash context (ctx).
+ */
+void
+spritz_hash_reset(spritz_ctx *hash_ctx)
+{
+  spritz_state_init(hash_ctx); /* Every byte of `s` and the registers are overwritten */
+#ifdef SPRITZ_WIPE_TRACES_PARANOID
+  hash_ctx->tmp1 = 0;
+  hash_ctx->tmp2 = 0;
+#endif
+}
+
 /** spritz_hash_update()
  * Add a message/data chunk `data` to hash.
  *
@@ -504,17 +1225,9 @@ void
 spritz_hash_final(spritz_ctx *hash_ctx,
                   uint8_t *digest, uint8_t digestLen)
 {
-  uint8_t i;
-
   absorbStop(hash_ctx);
   absorb(hash_ctx, digestLen);
-  /* squeeze() */
-  if (hash_ctx->a) {
-    shuffle(hash_ctx);
-  }
-  for (i = 0; i < digestLen; i++) {
-    digest[i] = drip(hash_ctx);
-  }
+  squeeze(hash_ctx, digest, digestLen);
 }
 
 /** spritz_hash()
@@ -530,6 +1243,7 @@ spritz_hash(uint8_t *digest, uint8_t digestLen,
             const uint8_t *data, uint16_t dataLen)
 {
   spritz_ctx hash_ctx;
+  SPRITZ_STATS_START;
 
   spritz_hash_setup(&hash_ctx); /* spritz_state_init() */
   spritz_hash_update(&hash_ctx, data, dataLen); /* absorbBytes() */
@@ -539,6 +1253,93 @@ spritz_hash(uint8_t *digest, uint8_t digestLen,
 #ifdef SPRITZ_WIPE_TRACES
   spritz_state_memzero(&hash_ctx);
 #endif
+  SPRITZ_STATS_STOP(SPRITZ_STATS_HASH);
+}
+
+
+/** spritz_hash_fields_update()
+ * Add the fields of a structured message to hash.
+ * Each field is absorbed with its length, then a stop,
+ * So different tuples never hash as the same data and no concatenation is needed.
+ *
+ * Parameter hash_ctx:    The hash context (ctx).
+ * Parameter fields:      The fields.
+ * Parameter fieldscount: Number of the fields.
+ */
+void
+spritz_hash_fields_update(spritz_ctx *hash_ctx,
+                          const spritz_field *fields, uint8_t fieldsCount)
+{
+  uint8_t i;
+
+  for (i = 0; i < fieldsCount; i++) {
+    /* 16-bit length, Little-endian */
+    absorb(hash_ctx, (uint8_t)(fields[i].len));
+    absorb(hash_ctx, (uint8_t)(fields[i].len >> 8));
+    absorbBytes(hash_ctx, fields[i].data, fields[i].len);
+    absorbStop(hash_ctx);
+  }
+}
+
+/** spritz_hash_fields()
+ * Cryptographic hash function of a structured message.
+ *
+ * Parameter digest:      The digest (hash) output.
+ * Parameter digestlen:   Length of the digest in bytes.
+ * Parameter fields:      The fields to hash.
+ * Parameter fieldscount: Number of the fields.
+ */
+void
+spritz_hash_fields(uint8_t *digest, uint8_t digestLen,
+                   const spritz_field *fields, uint8_t fieldsCount)
+{
+  spritz_ctx hash_ctx;
+  SPRITZ_STATS_START;
+
+  spritz_hash_setup(&hash_ctx); /* spritz_state_init() */
+  spritz_hash_fields_update(&hash_ctx, fields, fieldsCount);
+  spritz_hash_final(&hash_ctx, digest, digestLen);
+
+  /* `hash_ctx` data will be replaced with 0x00 if SPRITZ_WIPE_TRACES is defined */
+#ifdef SPRITZ_WIPE_TRACES
+  spritz_state_memzero(&hash_ctx);
+#endif
+  SPRITZ_STATS_STOP(SPRITZ_STATS_HASH);
+}
+
+/** spritz_hash_records()
+ * Hash an array of structured messages (records) with one work context `scratch`,
+ * Each record has its own digest.
+ *
+ * Parameter scratch:      The work context (Any content), Wiped at the end if SPRITZ_WIPE_TRACES is defined.
+ * Parameter digests:      The digests output, `recordscount * digestlen` bytes.
+ * Parameter digestlen:    Length of a digest in bytes.
+ * Parameter fields:       The fields, `recordscount * fieldscount` in records order.
+ * Parameter fieldscount:  Number of the fields in a record.
+ * Parameter recordscount: Number of the records.
+ */
+void
+spritz_hash_records(spritz_ctx *scratch,
+                    uint8_t *digests, uint8_t digestLen,
+                    const spritz_field *fields, uint8_t fieldsCount,
+                    uint16_t recordsCount)
+{
+  uint16_t i;
+  SPRITZ_STATS_START;
+
+  for (i = 0; i < recordsCount; i++) {
+    spritz_hash_reset(scratch);
+    spritz_hash_fields_update(scratch, fields, fieldsCount);
+    spritz_hash_final(scratch, digests, digestLen);
+    fields  += fieldsCount;
+    digests += digestLen;
+  }
+
+  /* `scratch` data will be replaced with 0x00 if SPRITZ_WIPE_TRACES is defined */
+#ifdef SPRITZ_WIPE_TRACES
+  spritz_state_memzero(scratch);
+#endif
+  SPRITZ_STATS_STOP(SPRITZ_STATS_HASH); /* One record for all the records */
 }
 
 
@@ -558,6 +1359,24 @@ spritz_mac_setup(spritz_ctx *mac_ctx,
   absorbStop(mac_ctx);
 }
 
+/** spritz_mac_reset()
+ * Reset a used message authentication code (MAC) context `spritz_ctx` for a new MAC.
+ * The previous state is overwritten by the setup in one pass,
+ * Use it instead of spritz_state_memzero() then spritz_mac_setup().
+ *
+ * Parameter mac_ctx: The message authentication code (MAC) context (ctx).
+ * Parameter key:     The secret key.
+ * Parameter keylen:  Length of the key in bytes.
+ */
+void
+spritz_mac_reset(spritz_ctx *mac_ctx,
+                 const uint8_t *key, uint16_t keyLen)
+{
+  spritz_hash_reset(mac_ctx);
+  spritz_hash_update(mac_ctx, key, keyLen); /* absorbBytes() */
+  absorbStop(mac_ctx);
+}
+
 /** spritz_mac_update()
  * Add a message/data chunk to message authentication code (MAC).
  *
@@ -602,6 +1421,7 @@ spritz_mac(uint8_t *digest, uint8_t digestLen,
            const uint8_t *key, uint16_t keyLen)
 {
   spritz_ctx mac_ctx;
+  SPRITZ_STATS_START;
 
   spritz_mac_setup(&mac_ctx, key, keyLen);
   spritz_mac_update(&mac_ctx, msg, msgLen); /* absorbBytes() */
@@ -611,4 +1431,364 @@ spritz_mac(uint8_t *digest, uint8_t digestLen,
 #ifdef SPRITZ_WIPE_TRACES
   spritz_state_memzero(&mac_ctx);
 #endif
+  SPRITZ_STATS_STOP(SPRITZ_STATS_MAC);
+}
+
+/** spritz_mac_fields()
+ * Message Authentication Code (MAC) function of a structured message.
+ * The fields are absorbed like in spritz_hash_fields_update().
+ *
+ * Parameter digest:      Message authentication code (MAC) digest output.
+ * Parameter digestlen:   Length of the digest in bytes.
+ * Parameter fields:      The fields to be authenticated.
+ * Parameter fieldscount: Number of the fields.
+ * Parameter key:         The secret key.
+ * Parameter keylen:      Length of the key in bytes.
+ */
+void
+spritz_mac_fields(uint8_t *digest, uint8_t digestLen,
+                  const spritz_field *fields, uint8_t fieldsCount,
+                  const uint8_t *key, uint16_t keyLen)
+{
+  spritz_ctx mac_ctx;
+  SPRITZ_STATS_START;
+
+  spritz_mac_setup(&mac_ctx, key, keyLen);
+  spritz_hash_fields_update(&mac_ctx, fields, fieldsCount);
+  spritz_mac_final(&mac_ctx, digest, digestLen);
+
+  /* `mac_ctx` data will be replaced with 0x00 if SPRITZ_WIPE_TRACES is defined */
+#ifdef SPRITZ_WIPE_TRACES
+  spritz_state_memzero(&mac_ctx);
+#endif
+  SPRITZ_STATS_STOP(SPRITZ_STATS_MAC);
 }
+
+/** spritz_mac_records()
+ * Message Authentication Code (MAC) of an array of structured messages (records)
+ * with one work context `scratch`, Each record has its own digest.
+ *
+ * Parameter scratch:      The work context (Any content), Wiped at the end if SPRITZ_WIPE_TRACES is defined.
+ * Parameter digests:      The digests output, `recordscount * digestlen` bytes.
+ * Parameter digestlen:    Length of a digest in bytes.
+ * Parameter fields:       The fields, `recordscount * fieldscount` in records order.
+ * Parameter fieldscount:  Number of the fields in a record.
+ * Parameter recordscount: Number of the records.
+ * Parameter mac_key_ctx:  The MAC state from spritz_mac_setup().
+ */
+void
+spritz_mac_records(spritz_ctx *scratch,
+                   uint8_t *digests, uint8_t digestLen,
+                   const spritz_field *fields, uint8_t fieldsCount,
+                   uint16_t recordsCount, const spritz_ctx *mac_key_ctx)
+{
+  uint16_t i;
+  SPRITZ_STATS_START;
+
+  for (i = 0; i < recordsCount; i++) {
+    *scratch = *mac_key_ctx; /* The key is not absorbed again */
+    spritz_hash_fields_update(scratch, fields, fieldsCount);
+    spritz_mac_final(scratch, digests, digestLen);
+    fields  += fieldsCount;
+    digests += digestLen;
+  }
+
+  /* `scratch` data will be replaced with 0x00 if SPRITZ_WIPE_TRACES is defined */
+#ifdef SPRITZ_WIPE_TRACES
+  spritz_state_memzero(scratch);
+#endif
+  SPRITZ_STATS_STOP(SPRITZ_STATS_MAC); /* One record for all the records */
+}
+
+
+/** spritz_hash_with()
+ * Cryptographic hash function with a caller-provided work context `scratch`.
+ *
+ * Parameter scratch:   The work context (Any content), Wiped at the end if SPRITZ_WIPE_TRACES is defined.
+ * Parameter digest:    The digest (hash) output.
+ * Parameter digestlen: Length of the digest in bytes.
+ * Parameter data:      The data to hash.
+ * Parameter datalen:   Length of the data in bytes.
+ */
+void
+spritz_hash_with(spritz_ctx *scratch,
+                 uint8_t *digest, uint8_t digestLen,
+                 const uint8_t *data, uint16_t dataLen)
+{
+  SPRITZ_STATS_START;
+
+  spritz_hash_reset(scratch); /* spritz_state_init() */
+  spritz_hash_update(scratch, data, dataLen); /* absorbBytes() */
+  spritz_hash_final(scratch, digest, digestLen);
+
+  /* `scratch` data will be replaced with 0x00 if SPRITZ_WIPE_TRACES is defined */
+#ifdef SPRITZ_WIPE_TRACES
+  spritz_state_memzero(scratch);
+#endif
+  SPRITZ_STATS_STOP(SPRITZ_STATS_HASH);
+}
+
+/** spritz_mac_with()
+ * Message Authentication Code (MAC) function with a caller-provided work context `scratch`.
+ *
+ * Parameter scratch:   The work context (Any content), Wiped at the end if SPRITZ_WIPE_TRACES is defined.
+ * Parameter digest:    Message authentication code (MAC) digest output.
+ * Parameter digestlen: Length of the digest in bytes.
+ * Parameter msg:       The message to be authenticated.
+ * Parameter msglen:    Length of the message in bytes.
+ * Parameter key:       The secret key.
+ * Parameter keylen:    Length of the key in bytes.
+ */
+void
+spritz_mac_with(spritz_ctx *scratch,
+                uint8_t *digest, uint8_t digestLen,
+                const uint8_t *msg, uint16_t msgLen,
+                const uint8_t *key, uint16_t keyLen)
+{
+  SPRITZ_STATS_START;
+
+  spritz_mac_reset(scratch, key, keyLen);
+  spritz_mac_update(scratch, msg, msgLen); /* absorbBytes() */
+  spritz_mac_final(scratch, digest, digestLen);
+
+  /* `scratch` data will be replaced with 0x00 if SPRITZ_WIPE_TRACES is defined */
+#ifdef SPRITZ_WIPE_TRACES
+  spritz_state_memzero(scratch);
+#endif
+  SPRITZ_STATS_STOP(SPRITZ_STATS_MAC);
+}
+
+/** spritz_hash_batch()
+ * Hash an array of messages with one work context `scratch`, Each digest is the same as from spritz_hash().
+ *
+ * Parameter scratch:   The work context (Any content), Wiped at the end if SPRITZ_WIPE_TRACES is defined.
+ * Parameter digests:   The digests output, `msgscount * digestlen` bytes.
+ * Parameter digestlen: Length of a digest in bytes.
+ * Parameter msgs:      The messages.
+ * Parameter msgscount: Number of the messages.
+ */
+void
+spritz_hash_batch(spritz_ctx *scratch,
+                  uint8_t *digests, uint8_t digestLen,
+                  const spritz_message *msgs, uint16_t msgsCount)
+{
+  uint16_t i;
+  SPRITZ_STATS_START;
+
+  for (i = 0; i < msgsCount; i++) {
+    spritz_hash_reset(scratch); /* spritz_state_init() */
+    spritz_hash_update(scratch, msgs[i].data, msgs[i].len); /* absorbBytes() */
+    spritz_hash_final(scratch, digests, digestLen);
+    digests += digestLen;
+  }
+
+  /* `scratch` data will be replaced with 0x00 if SPRITZ_WIPE_TRACES is defined */
+#ifdef SPRITZ_WIPE_TRACES
+  spritz_state_memzero(scratch);
+#endif
+  SPRITZ_STATS_STOP(SPRITZ_STATS_HASH); /* One record for all the messages */
+}
+
+/** spritz_mac_batch()
+ * Message Authentication Code (MAC) of an array of messages with one work context `scratch`,
+ * Each digest is the same as from spritz_mac().
+ *
+ * Parameter scratch:     The work context (Any content), Wiped at the end if SPRITZ_WIPE_TRACES is defined.
+ * Parameter digests:     The digests output, `msgscount * digestlen` bytes.
+ * Parameter digestlen:   Length of a digest in bytes.
+ * Parameter msgs:        The messages to be authenticated.
+ * Parameter msgscount:   Number of the messages.
+ * Parameter mac_key_ctx: The MAC state from spritz_mac_setup().
+ */
+void
+spritz_mac_batch(spritz_ctx *scratch,
+                 uint8_t *digests, uint8_t digestLen,
+                 const spritz_message *msgs, uint16_t msgsCount,
+                 const spritz_ctx *mac_key_ctx)
+{
+  uint16_t i;
+  SPRITZ_STATS_START;
+
+  for (i = 0; i < msgsCount; i++) {
+    *scratch = *mac_key_ctx; /* The key is not absorbed again */
+    spritz_mac_update(scratch, msgs[i].data, msgs[i].len);
+    spritz_mac_final(scratch, digests, digestLen);
+    digests += digestLen;
+  }
+
+  /* `scratch` data (A key-derived state) will be replaced with 0x00 if SPRITZ_WIPE_TRACES is defined */
+#ifdef SPRITZ_WIPE_TRACES
+  spritz_state_memzero(scratch);
+#endif
+  SPRITZ_STATS_STOP(SPRITZ_STATS_MAC); /* One record for all the messages */
+}
+
+
+#ifdef SPRITZ_STATS
+/** spritz_stats_snapshot()
+ * Copy the recorded latency histograms to `stats`.
+ *
+ * Parameter stats: The snapshot output.
+ */
+void
+spritz_stats_snapshot(spritz_stats *stats)
+{
+  *stats = statsData;
+}
+
+/** spritz_stats_reset()
+ * Clear the recorded latency histograms.
+ */
+void
+spritz_stats_reset(void)
+{
+  spritz_memzero((uint8_t *)&statsData, (uint16_t)sizeof(statsData));
+}
+
+/** spritz_stats_percentile()
+ * The latency that `permille` per thousand of the recorded calls do not exceed.
+ *
+ * Parameter hist:     The histogram of an operation.
+ * Parameter permille: The percentile in per mille.
+ *
+ * Return: The latency in ticks, Zero if no call is recorded.
+ */
+uint32_t
+spritz_stats_percentile(const spritz_stats_hist *hist, uint16_t permille)
+{
+  uint32_t rank, seen = 0;
+  uint8_t b;
+
+  if (!hist->count) {
+    return 0;
+  }
+  if (permille > 1000) {
+    permille = 1000;
+  }
+  /* ceil(count * permille / 1000) without overflow */
+  rank = (hist->count / 1000) * permille + ((hist->count % 1000) * permille + 999) / 1000;
+  if (!rank) {
+    rank = 1;
+  }
+  for (b = 0; b < (SPRITZ_STATS_BUCKETS - 1); b++) {
+    seen += hist->buckets[b];
+    if (seen >= rank) {
+      break;
+    }
+  }
+  /* The upper bound of the bucket `b`, The last bucket has no bound */
+  if (b == (SPRITZ_STATS_BUCKETS - 1) || (((uint32_t)1 << b) - 1) > hist->max) {
+    return hist->max;
+  }
+  return ((uint32_t)1 << b) - 1;
+}
+
+
+/* Append the string `str` to `buf` at `pos`, Keep a byte for the null character */
+static uint16_t
+statsPut(char *buf, uint16_t bufLen, uint16_t pos, const char *str)
+{
+  while (*str && (uint16_t)(pos + 1) < bufLen) {
+    buf[pos++] = *str++;
+  }
+  return pos;
+}
+
+/* Append the decimal number `n` to `buf` at `pos` */
+static uint16_t
+statsPutNum(char *buf, uint16_t bufLen, uint16_t pos, uint32_t n)
+{
+  char digits[11]; /* 4294967295 and a null character */
+  uint8_t d = sizeof(digits) - 1;
+
+  digits[d] = '\0';
+  do {
+    digits[--d] = (char)('0' + (n % 10));
+    n /= 10;
+  } while (n);
+  return statsPut(buf, bufLen, pos, digits + d);
+}
+
+/* Write a snapshot as a text table or as JSON */
+static uint16_t
+statsDump(const spritz_stats *stats, char *buf, uint16_t bufLen, uint8_t json)
+{
+  static const char *const opNames[SPRITZ_STATS_OPS] = { "setup", "crypt", "hash", "mac", "packets" };
+  static const char *const valueNames[6] = { "count", "min", "p50", "p99", "p999", "max" };
+  const spritz_stats_hist *hist;
+  uint32_t values[6];
+  uint16_t pos = 0;
+  uint8_t op, v;
+
+  if (!bufLen) {
+    return 0;
+  }
+  pos = statsPut(buf, bufLen, pos, json ? "{" : "op\tcount\tmin\tp50\tp99\tp999\tmax\n");
+  for (op = 0; op < SPRITZ_STATS_OPS; op++) {
+    hist = &stats->op[op];
+    values[0] = hist->count;
+    values[1] = hist->min;
+    values[2] = spritz_stats_percentile(hist, 500);
+    values[3] = spritz_stats_percentile(hist, 990);
+    values[4] = spritz_stats_percentile(hist, 999);
+    values[5] = hist->max;
+
+    if (json) {
+      pos = statsPut(buf, bufLen, pos, op ? ",\"" : "\"");
+      pos = statsPut(buf, bufLen, pos, opNames[op]);
+      pos = statsPut(buf, bufLen, pos, "\":{");
+      for (v = 0; v < 6; v++) {
+        pos = statsPut(buf, bufLen, pos, v ? ",\"" : "\"");
+        pos = statsPut(buf, bufLen, pos, valueNames[v]);
+        pos = statsPut(buf, bufLen, pos, "\":");
+        pos = statsPutNum(buf, bufLen, pos, values[v]);
+      }
+      pos = statsPut(buf, bufLen, pos, "}");
+    }
+    else {
+      pos = statsPut(buf, bufLen, pos, opNames[op]);
+      for (v = 0; v < 6; v++) {
+        pos = statsPut(buf, bufLen, pos, "\t");
+        pos = statsPutNum(buf, bufLen, pos, values[v]);
+      }
+      pos = statsPut(buf, bufLen, pos, "\n");
+    }
+  }
+  if (json) {
+    pos = statsPut(buf, bufLen, pos, "}");
+  }
+  buf[pos] = '\0';
+
+  return pos;
+}
+
+/** spritz_stats_text()
+ * Write a snapshot as a text table.
+ *
+ * Parameter stats:  The snapshot.
+ * Parameter buf:    The text output.
+ * Parameter buflen: Size of `buf` in bytes.
+ *
+ * Return: Length of the text in bytes, Without the null character.
+ */
+uint16_t
+spritz_stats_text(const spritz_stats *stats, char *buf, uint16_t bufLen)
+{
+  return statsDump(stats, buf, bufLen, 0);
+}
+
+/** spritz_stats_json()
+ * Write a snapshot as a JSON object.
+ *
+ * Parameter stats:  The snapshot.
+ * Parameter buf:    The JSON output.
+ * Parameter buflen: Size of `buf` in bytes.
+ *
+ * Return: Length of the JSON in bytes, Without the null character.
+ */
+uint16_t
+spritz_stats_json(const spritz_stats *stats, char *buf, uint16_t bufLen)
+{
+  return statsDump(stats, buf, bufLen, 1);
+}
+#endif
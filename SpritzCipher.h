@@ -32,6 +32,7 @@ extern "C" {
 
 
 #include <stdint.h> /* uint8_t, uint16_t, uint32_t */
+#include <stddef.h> /* size_t */
 
 
 /** SPRITZ_TIMING_SAFE_CRUSH
@@ -67,6 +68,40 @@ extern "C" {
 # endif
 #endif
 
+/** SPRITZ_POOL_SIZE
+ * Size of the random bytes pool `spritz_pool` in bytes (1 to 65535).
+ */
+#define SPRITZ_POOL_SIZE 32
+
+/** SPRITZ_CACHE_LINE
+ * Size of a CPU cache line in bytes, For `spritz_ctx_padded`.
+ */
+#define SPRITZ_CACHE_LINE 64
+
+/** SPRITZ_STATS
+ * If defined, The latency of the setup, spritz_crypt(), one-shot hash and MAC functions
+ * and the packets functions is recorded in log2 histograms, Read them by spritz_stats_snapshot().
+ * It costs two SPRITZ_STATS_CLOCK() calls per function call and about 700 bytes of RAM.
+ * Recording is not safe in interrupts or from more than one thread (or CPU core),
+ * SpritzChannel::commit() and receive() are not recorded so they stay usable in interrupts.
+ */
+/* #define SPRITZ_STATS */
+
+/** SPRITZ_STATS_CLOCK
+ * The clock of SPRITZ_STATS, A function that returns uint32_t ticks.
+ * micros() in Arduino, Else spritz_stats_clock() that the application defines
+ * (like a CPU cycle counter).
+ */
+#ifdef SPRITZ_STATS
+# ifndef SPRITZ_STATS_CLOCK
+#  ifdef ARDUINO
+#   define SPRITZ_STATS_CLOCK micros
+#  else
+#   define SPRITZ_STATS_CLOCK spritz_stats_clock
+#  endif
+# endif
+#endif
+
 /** SPRITZ_N
  * Present the value of N in this spritz implementation, DO NOT change SPRITZ_N value.
  */
@@ -93,6 +128,116 @@ typedef struct
 #endif
 } spritz_ctx;
 
+/** spritz_ctx_padded
+ * A spritz_ctx aligned and padded to whole cache lines (`SPRITZ_CACHE_LINE`).
+ * In an array of contexts used by different CPU cores, Contexts do NOT share a cache line,
+ * So a core writing its registers (i, j, k, z, a, w) does not slow the others (false sharing).
+ * Use `&padded.ctx` with the library functions.
+ * Not needed on CPUs without a data cache (like AVR), It only wastes memory there.
+ */
+typedef union
+{
+  spritz_ctx ctx;
+  uint8_t pad[(sizeof(spritz_ctx) + SPRITZ_CACHE_LINE - 1) / SPRITZ_CACHE_LINE * SPRITZ_CACHE_LINE];
+}
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__ ((aligned(SPRITZ_CACHE_LINE)))
+#endif
+spritz_ctx_padded;
+
+/** spritz_field
+ * A field of a structured message (tuple), `len` bytes at `data`.
+ */
+typedef struct
+{
+  const uint8_t *data;
+  uint16_t len;
+} spritz_field;
+
+/** spritz_message
+ * A whole message of spritz_hash_batch() and spritz_mac_batch(), `len` bytes at `data`.
+ * Hashed like spritz_hash() (Not a field, No length is absorbed).
+ */
+typedef struct
+{
+  const uint8_t *data;
+  uint16_t len;
+} spritz_message;
+
+/** spritz_packet
+ * A datagram for spritz_seal_packets() and spritz_open_packets().
+ * `data` is encrypted or decrypted in place.
+ */
+typedef struct
+{
+  uint8_t *data;
+  uint16_t len;
+  const uint8_t *nonce;
+  uint8_t nonceLen;
+  uint8_t *tag;
+} spritz_packet;
+
+/** spritz_nonce_ctx
+ * Counter nonces allocator, Counters below `reserved` are persisted as used.
+ * `next` is the next counter to give, `step` is how many counters are reserved at a time.
+ * `persist` stores the new high-water mark (e.g. in EEPROM), Returns zero on success.
+ * `exhausted` is non-zero after the counter 0xffffffff is given, The mark 0xffffffff means all are used.
+ */
+typedef struct
+{
+  uint32_t next;
+  uint32_t reserved;
+  uint32_t step;
+  uint8_t (*persist)(uint32_t highWaterMark);
+  uint8_t exhausted;
+} spritz_nonce_ctx;
+
+/** spritz_pool
+ * Random bytes pool, A spritz_ctx with a block of pre-generated bytes.
+ * `pos` is the index of the next unused byte in `buf`.
+ */
+typedef struct
+{
+  spritz_ctx ctx;
+  uint8_t buf[SPRITZ_POOL_SIZE];
+  uint16_t pos;
+} spritz_pool;
+
+#ifdef SPRITZ_STATS
+/* The operations of SPRITZ_STATS, Indices of `spritz_stats.op`.
+ * A public function call is one record (Even with many records, messages or contexts),
+ * The functions it uses inside are not recorded.
+ */
+# define SPRITZ_STATS_SETUP   0 /* spritz_setup*(), spritz_key_setup() */
+# define SPRITZ_STATS_CRYPT   1 /* spritz_crypt(), spritz_crypt_interleaved() */
+# define SPRITZ_STATS_HASH    2 /* spritz_hash(), spritz_hash_fields(), spritz_hash_with(), spritz_hash_records(), spritz_hash_batch() */
+# define SPRITZ_STATS_MAC     3 /* spritz_mac(), spritz_mac_fields(), spritz_mac_with(), spritz_mac_records(), spritz_mac_batch() */
+# define SPRITZ_STATS_PACKETS 4 /* spritz_seal_packets(), spritz_open_packets() (The burst, Its setups and tags included) */
+# define SPRITZ_STATS_OPS     5
+
+/* Bucket `b` counts the latencies of `b` bits, [2^(b-1), 2^b - 1], The last one also counts longer latencies */
+# define SPRITZ_STATS_BUCKETS 32
+
+/** spritz_stats_hist
+ * Latency histogram of an operation, In SPRITZ_STATS_CLOCK() ticks.
+ */
+typedef struct
+{
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint32_t buckets[SPRITZ_STATS_BUCKETS];
+} spritz_stats_hist;
+
+/** spritz_stats
+ * The latency histograms of all operations.
+ */
+typedef struct
+{
+  spritz_stats_hist op[SPRITZ_STATS_OPS];
+} spritz_stats;
+#endif
+
 /** spritz_compare()
  * Timing-safe equality comparison for `data_a` and `data_b`.
  * This function can be used to compare the password's hash safely.
@@ -151,6 +296,59 @@ spritz_setup_withIV(spritz_ctx *ctx,
                     const uint8_t *key, uint8_t keyLen,
                     const uint8_t *nonce, uint8_t nonceLen);
 
+/** spritz_setup_long()
+ * Setup the spritz state `spritz_ctx` with a key of any length.
+ * Same as spritz_setup() for keys shorter than 256 bytes.
+ *
+ * Parameter ctx:    The context.
+ * Parameter key:    The key.
+ * Parameter keylen: Length of the key in bytes.
+ */
+void
+spritz_setup_long(spritz_ctx *ctx,
+                  const uint8_t *key, size_t keyLen);
+
+/** spritz_setup_withIV_long()
+ * Setup the spritz state `spritz_ctx` with a key and nonce/salt/iv of any length.
+ * Same as spritz_setup_withIV() for keys and nonces shorter than 256 bytes.
+ *
+ * Parameter ctx:      The context.
+ * Parameter key:      The key.
+ * Parameter keylen:   Length of the key in bytes.
+ * Parameter nonce:    The nonce (salt).
+ * Parameter noncelen: Length of the nonce in bytes.
+ */
+void
+spritz_setup_withIV_long(spritz_ctx *ctx,
+                         const uint8_t *key, size_t keyLen,
+                         const uint8_t *nonce, size_t nonceLen);
+
+/** spritz_key_setup()
+ * Absorb a key in `key_ctx` only, To be used as a cached keyed state by
+ * spritz_setup_withIV_fromKey() for many nonces.
+ *
+ * Parameter key_ctx: The keyed state.
+ * Parameter key:     The key.
+ * Parameter keylen:  Length of the key in bytes.
+ */
+void
+spritz_key_setup(spritz_ctx *key_ctx,
+                 const uint8_t *key, uint8_t keyLen);
+
+/** spritz_setup_withIV_fromKey()
+ * Setup the spritz state `spritz_ctx` with a cached keyed state and nonce/salt/iv.
+ * The result is the same as spritz_setup_withIV() with the key of `key_ctx`,
+ * Without absorbing the key again.
+ *
+ * Parameter ctx:      The context.
+ * Parameter key_ctx:  The keyed state from spritz_key_setup().
+ * Parameter nonce:    The nonce (salt).
+ * Parameter noncelen: Length of the nonce in bytes.
+ */
+void
+spritz_setup_withIV_fromKey(spritz_ctx *ctx, const spritz_ctx *key_ctx,
+                            const uint8_t *nonce, uint8_t nonceLen);
+
 /** spritz_random8()
  * Generates a random byte from the spritz state `spritz_ctx`.
  * Usable only after calling spritz_setup() or spritz_setup_withiv().
@@ -162,6 +360,19 @@ spritz_setup_withIV(spritz_ctx *ctx,
 uint8_t
 spritz_random8(spritz_ctx *ctx);
 
+/** spritz_random_bytes()
+ * Generates `len` random bytes from the spritz state `spritz_ctx` in one block.
+ * The output is the same as calling spritz_random8() `len` times, But faster.
+ * Usable only after calling spritz_setup() or spritz_setup_withiv().
+ *
+ * Parameter ctx: The context.
+ * Parameter buf: The output.
+ * Parameter len: Length of the output in bytes.
+ */
+void
+spritz_random_bytes(spritz_ctx *ctx,
+                    uint8_t *buf, uint16_t len);
+
 /** spritz_random32()
  * Generates a random 32-bit (4 bytes) from the spritz state `spritz_ctx`.
  * Usable only after calling spritz_setup() or spritz_setup_withiv().
@@ -193,6 +404,22 @@ spritz_random32(spritz_ctx *ctx);
 uint32_t
 spritz_random32_uniform(spritz_ctx *ctx, uint32_t upper_bound);
 
+/** spritz_shuffle()
+ * Shuffle an array of `count` records of `size` bytes each in place (Fisher-Yates).
+ * The random indices are taken from batches of random bytes without modulo bias,
+ * Not from a spritz_random32_uniform() call per record.
+ * Every order is equally likely, And the same state gives the same order.
+ * Usable only after calling spritz_setup() or spritz_setup_withiv().
+ *
+ * Parameter ctx:   The context.
+ * Parameter base:  The records.
+ * Parameter count: Number of the records.
+ * Parameter size:  Length of a record in bytes.
+ */
+void
+spritz_shuffle(spritz_ctx *ctx,
+               uint8_t *base, uint16_t count, uint16_t size);
+
 /** spritz_add_entropy()
  * Add entropy to the spritz state `spritz_ctx` using absorb().
  * Usable only after calling spritz_setup() or spritz_setup_withiv().
@@ -220,6 +447,130 @@ spritz_crypt(spritz_ctx *ctx,
              uint8_t *dataOut);
 
 
+/** spritz_crypt_interleaved()
+ * Encrypt or decrypt data chunks of independent contexts in one loop.
+ * The output is the same as calling spritz_crypt() for each context,
+ * But the dependent loads of the contexts overlap, That is faster on CPUs
+ * that can execute more than one instruction at a time.
+ * The contexts are processed four (or two) at a time, As `ctxcount` allows.
+ * Usable only after calling spritz_setup() or spritz_setup_withiv() for each context.
+ *
+ * Parameter ctx:      The contexts, They MUST be different contexts.
+ * Parameter ctxcount: Number of the contexts.
+ * Parameter data:     The data chunk of each context.
+ * Parameter datalen:  Length of each data chunk in bytes.
+ * Parameter dataout:  The output of each context.
+ */
+void
+spritz_crypt_interleaved(spritz_ctx *const *ctx, uint8_t ctxCount,
+                         const uint8_t *const *data, uint16_t dataLen,
+                         uint8_t *const *dataOut);
+
+/** spritz_seal_packets()
+ * Encrypt a burst of packets in place and compute their tags (Encrypt-then-MAC).
+ * The keystream of a packet is from spritz_setup_withIV_fromKey() with the packet nonce,
+ * Its tag is the MAC of its nonce and ciphertext from the cached MAC state `mac_key_ctx`.
+ * The packets are encrypted `scratchcount` at a time by spritz_crypt_interleaved().
+ *
+ * Parameter key_ctx:      The keyed state from spritz_key_setup().
+ * Parameter mac_key_ctx:  The MAC state from spritz_mac_setup() (Use a different key).
+ * Parameter packets:      The packets, Never reuse a nonce with the same key.
+ * Parameter packetscount: Number of the packets.
+ * Parameter taglen:       Length of a tag in bytes (1 to 32), Longer is cut to 32 by both functions,
+ *                         If zero nothing is done (No packet can be authenticated).
+ * Parameter scratch:      Work contexts, They are wiped before returning.
+ * Parameter scratchcount: Number of the work contexts (One or more), If zero nothing is done.
+ */
+void
+spritz_seal_packets(const spritz_ctx *key_ctx, const spritz_ctx *mac_key_ctx,
+                    spritz_packet *packets, uint8_t packetsCount, uint8_t tagLen,
+                    spritz_ctx *scratch, uint8_t scratchCount);
+
+/** spritz_open_packets()
+ * Verify a burst of packets from spritz_seal_packets(), Then decrypt the authentic ones in place.
+ * The `len` of a packet that failed authentication is set to zero, And its data is not decrypted.
+ *
+ * Parameters: Like spritz_seal_packets().
+ *
+ * Return: Number of the authentic packets, Zero if `scratchcount` is zero,
+ *         Zero if `taglen` is zero and the `len` of every packet is set to zero.
+ */
+uint8_t
+spritz_open_packets(const spritz_ctx *key_ctx, const spritz_ctx *mac_key_ctx,
+                    spritz_packet *packets, uint8_t packetsCount, uint8_t tagLen,
+                    spritz_ctx *scratch, uint8_t scratchCount);
+
+/** spritz_nonce_setup()
+ * Setup the nonces allocator from the stored high-water mark.
+ * No reserved counter is persisted yet, So the first allocation persists a new mark.
+ *
+ * Parameter nonce_ctx:     The nonces allocator.
+ * Parameter highwatermark: The last persisted high-water mark (0 the first time).
+ * Parameter step:          Number of the counters reserved by a write (One or more).
+ * Parameter persist:       The function that stores a high-water mark, Returns zero on success.
+ */
+void
+spritz_nonce_setup(spritz_nonce_ctx *nonce_ctx, uint32_t highWaterMark, uint32_t step,
+                   uint8_t (*persist)(uint32_t highWaterMark));
+
+/** spritz_nonce_range()
+ * Allocate `count` consecutive counters, That are never given again even after a reset.
+ * The high-water mark is persisted only when the reserved counters are used up.
+ *
+ * Parameter nonce_ctx: The nonces allocator.
+ * Parameter count:     Number of the counters.
+ * Parameter first:     Output, The first counter of the range.
+ *
+ * Return: Zero on success, Non-zero value if the counters are exhausted
+ *         (Change the key) or the high-water mark can not be persisted.
+ */
+uint8_t
+spritz_nonce_range(spritz_nonce_ctx *nonce_ctx, uint32_t count, uint32_t *first);
+
+/** spritz_nonce_next()
+ * Allocate one counter as a 4 bytes nonce (Little-endian) for spritz_setup_withIV().
+ *
+ * Parameter nonce_ctx: The nonces allocator.
+ * Parameter nonce:     Output, The nonce (4 bytes).
+ *
+ * Return: Zero on success, Non-zero value like spritz_nonce_range().
+ */
+uint8_t
+spritz_nonce_next(spritz_nonce_ctx *nonce_ctx, uint8_t *nonce);
+
+/** spritz_pool_setup()
+ * Setup the random bytes pool `spritz_pool` with a seed, Then fill it.
+ *
+ * Parameter pool:    The pool.
+ * Parameter seed:    The seed (entropy).
+ * Parameter seedlen: Length of the seed in bytes.
+ */
+void
+spritz_pool_setup(spritz_pool *pool,
+                  const uint8_t *seed, uint8_t seedLen);
+
+/** spritz_pool_refill()
+ * Generate the used bytes of the pool in one block.
+ * Call it when the program is idle, So spritz_pool_random() will only copy bytes.
+ *
+ * Parameter pool: The pool.
+ */
+void
+spritz_pool_refill(spritz_pool *pool);
+
+/** spritz_pool_random()
+ * Get random bytes from the pool, The given bytes are wiped from the pool.
+ * The pool is refilled when it is empty.
+ *
+ * Parameter pool: The pool.
+ * Parameter buf:  The output.
+ * Parameter len:  Length of the output in bytes.
+ */
+void
+spritz_pool_random(spritz_pool *pool,
+                   uint8_t *buf, uint16_t len);
+
+
 /** spritz_hash_setup()
  * Setup the spritz hash state `spritz_ctx`.
  *
@@ -228,6 +579,16 @@ spritz_crypt(spritz_ctx *ctx,
 void
 spritz_hash_setup(spritz_ctx *hash_ctx);
 
+/** spritz_hash_reset()
+ * Reset a used hash context `spritz_ctx` for a new hash.
+ * The previous state is overwritten by the setup in one pass,
+ * Use it instead of spritz_state_memzero() then spritz_hash_setup().
+ *
+ * Parameter hash_ctx: The hash context (ctx).
+ */
+void
+spritz_hash_reset(spritz_ctx *hash_ctx);
+
 /** spritz_hash_update()
  * Add a message/data chunk `data` to hash.
  *
@@ -263,6 +624,49 @@ spritz_hash(uint8_t *digest, uint8_t digestLen,
             const uint8_t *data, uint16_t dataLen);
 
 
+/** spritz_hash_fields_update()
+ * Add the fields of a structured message to hash.
+ * Each field is absorbed with its length, then a stop,
+ * So different tuples never hash as the same data and no concatenation is needed.
+ *
+ * Parameter hash_ctx:    The hash context (ctx).
+ * Parameter fields:      The fields.
+ * Parameter fieldscount: Number of the fields.
+ */
+void
+spritz_hash_fields_update(spritz_ctx *hash_ctx,
+                          const spritz_field *fields, uint8_t fieldsCount);
+
+/** spritz_hash_fields()
+ * Cryptographic hash function of a structured message.
+ *
+ * Parameter digest:      The digest (hash) output.
+ * Parameter digestlen:   Length of the digest in bytes.
+ * Parameter fields:      The fields to hash.
+ * Parameter fieldscount: Number of the fields.
+ */
+void
+spritz_hash_fields(uint8_t *digest, uint8_t digestLen,
+                   const spritz_field *fields, uint8_t fieldsCount);
+
+/** spritz_hash_records()
+ * Hash an array of structured messages (records) with one work context `scratch`,
+ * Each record has its own digest.
+ *
+ * Parameter scratch:      The work context (Any content), Wiped at the end if SPRITZ_WIPE_TRACES is defined.
+ * Parameter digests:      The digests output, `recordscount * digestlen` bytes.
+ * Parameter digestlen:    Length of a digest in bytes.
+ * Parameter fields:       The fields, `recordscount * fieldscount` in records order.
+ * Parameter fieldscount:  Number of the fields in a record.
+ * Parameter recordscount: Number of the records.
+ */
+void
+spritz_hash_records(spritz_ctx *scratch,
+                    uint8_t *digests, uint8_t digestLen,
+                    const spritz_field *fields, uint8_t fieldsCount,
+                    uint16_t recordsCount);
+
+
 /** spritz_mac_setup()
  * Setup the spritz message authentication code (MAC) state `spritz_ctx`.
  *
@@ -274,6 +678,19 @@ void
 spritz_mac_setup(spritz_ctx *mac_ctx,
                  const uint8_t *key, uint16_t keyLen);
 
+/** spritz_mac_reset()
+ * Reset a used message authentication code (MAC) context `spritz_ctx` for a new MAC.
+ * The previous state is overwritten by the setup in one pass,
+ * Use it instead of spritz_state_memzero() then spritz_mac_setup().
+ *
+ * Parameter mac_ctx: The message authentication code (MAC) context (ctx).
+ * Parameter key:     The secret key.
+ * Parameter keylen:  Length of the key in bytes.
+ */
+void
+spritz_mac_reset(spritz_ctx *mac_ctx,
+                 const uint8_t *key, uint16_t keyLen);
+
 /** spritz_mac_update()
  * Add a message/data chunk to message authentication code (MAC).
  *
@@ -311,6 +728,174 @@ spritz_mac(uint8_t *digest, uint8_t digestLen,
            const uint8_t *msg, uint16_t msgLen,
            const uint8_t *key, uint16_t keyLen);
 
+/** spritz_mac_fields()
+ * Message Authentication Code (MAC) function of a structured message.
+ * The fields are absorbed like in spritz_hash_fields_update().
+ *
+ * Parameter digest:      Message authentication code (MAC) digest output.
+ * Parameter digestlen:   Length of the digest in bytes.
+ * Parameter fields:      The fields to be authenticated.
+ * Parameter fieldscount: Number of the fields.
+ * Parameter key:         The secret key.
+ * Parameter keylen:      Length of the key in bytes.
+ */
+void
+spritz_mac_fields(uint8_t *digest, uint8_t digestLen,
+                  const spritz_field *fields, uint8_t fieldsCount,
+                  const uint8_t *key, uint16_t keyLen);
+
+/** spritz_mac_records()
+ * Message Authentication Code (MAC) of an array of structured messages (records)
+ * with one work context `scratch`, Each record has its own digest.
+ * The key is absorbed once in `mac_key_ctx` and it is copied to `scratch` for each record.
+ * The digest of a record is the same as from spritz_mac_fields().
+ *
+ * Parameter scratch:      The work context (Any content), Wiped at the end if SPRITZ_WIPE_TRACES is defined.
+ * Parameter digests:      The digests output, `recordscount * digestlen` bytes.
+ * Parameter digestlen:    Length of a digest in bytes.
+ * Parameter fields:       The fields, `recordscount * fieldscount` in records order.
+ * Parameter fieldscount:  Number of the fields in a record.
+ * Parameter recordscount: Number of the records.
+ * Parameter mac_key_ctx:  The MAC state from spritz_mac_setup().
+ */
+void
+spritz_mac_records(spritz_ctx *scratch,
+                   uint8_t *digests, uint8_t digestLen,
+                   const spritz_field *fields, uint8_t fieldsCount,
+                   uint16_t recordsCount, const spritz_ctx *mac_key_ctx);
+
+/** spritz_hash_with()
+ * Cryptographic hash function with a caller-provided work context `scratch`.
+ * Like spritz_hash(), But `scratch` is reset instead of placing a spritz_ctx on the stack,
+ * And it is wiped at the end if SPRITZ_WIPE_TRACES is defined, Like the other `scratch` functions.
+ *
+ * Parameter scratch:   The work context (Any content), Wiped at the end if SPRITZ_WIPE_TRACES is defined.
+ * Parameter digest:    The digest (hash) output.
+ * Parameter digestlen: Length of the digest in bytes.
+ * Parameter data:      The data to hash.
+ * Parameter datalen:   Length of the data in bytes.
+ */
+void
+spritz_hash_with(spritz_ctx *scratch,
+                 uint8_t *digest, uint8_t digestLen,
+                 const uint8_t *data, uint16_t dataLen);
+
+/** spritz_mac_with()
+ * Message Authentication Code (MAC) function with a caller-provided work context `scratch`.
+ * Like spritz_mac(), But `scratch` is reset instead of placing a spritz_ctx on the stack,
+ * And it is wiped at the end if SPRITZ_WIPE_TRACES is defined, Like the other `scratch` functions.
+ *
+ * Parameter scratch:   The work context (Any content), Wiped at the end if SPRITZ_WIPE_TRACES is defined.
+ * Parameter digest:    Message authentication code (MAC) digest output.
+ * Parameter digestlen: Length of the digest in bytes.
+ * Parameter msg:       The message to be authenticated.
+ * Parameter msglen:    Length of the message in bytes.
+ * Parameter key:       The secret key.
+ * Parameter keylen:    Length of the key in bytes.
+ */
+void
+spritz_mac_with(spritz_ctx *scratch,
+                uint8_t *digest, uint8_t digestLen,
+                const uint8_t *msg, uint16_t msgLen,
+                const uint8_t *key, uint16_t keyLen);
+
+/** spritz_hash_batch()
+ * Hash an array of messages with one work context `scratch`, Each message has its own digest.
+ * The digest of a message is the same as from spritz_hash().
+ *
+ * Parameter scratch:   The work context (Any content), Wiped at the end if SPRITZ_WIPE_TRACES is defined.
+ * Parameter digests:   The digests output, `msgscount * digestlen` bytes.
+ * Parameter digestlen: Length of a digest in bytes.
+ * Parameter msgs:      The messages.
+ * Parameter msgscount: Number of the messages.
+ */
+void
+spritz_hash_batch(spritz_ctx *scratch,
+                  uint8_t *digests, uint8_t digestLen,
+                  const spritz_message *msgs, uint16_t msgsCount);
+
+/** spritz_mac_batch()
+ * Message Authentication Code (MAC) of an array of messages with one work context `scratch`.
+ * The key is absorbed once in `mac_key_ctx`, And it is copied to `scratch` for each message.
+ * The digest of a message is the same as from spritz_mac().
+ *
+ * Parameter scratch:     The work context (Any content), Wiped at the end if SPRITZ_WIPE_TRACES is defined.
+ * Parameter digests:     The digests output, `msgscount * digestlen` bytes.
+ * Parameter digestlen:   Length of a digest in bytes.
+ * Parameter msgs:        The messages to be authenticated.
+ * Parameter msgscount:   Number of the messages.
+ * Parameter mac_key_ctx: The MAC state from spritz_mac_setup().
+ */
+void
+spritz_mac_batch(spritz_ctx *scratch,
+                 uint8_t *digests, uint8_t digestLen,
+                 const spritz_message *msgs, uint16_t msgsCount,
+                 const spritz_ctx *mac_key_ctx);
+
+
+#ifdef SPRITZ_STATS
+# ifndef ARDUINO
+/** spritz_stats_clock()
+ * The default SPRITZ_STATS_CLOCK() out of Arduino, Defined by the application.
+ *
+ * Return: The clock ticks, It may wrap around.
+ */
+uint32_t
+spritz_stats_clock(void);
+# endif
+
+/** spritz_stats_snapshot()
+ * Copy the recorded latency histograms to `stats`.
+ *
+ * Parameter stats: The snapshot output.
+ */
+void
+spritz_stats_snapshot(spritz_stats *stats);
+
+/** spritz_stats_reset()
+ * Clear the recorded latency histograms.
+ */
+void
+spritz_stats_reset(void);
+
+/** spritz_stats_percentile()
+ * The latency that `permille` per thousand of the recorded calls do not exceed.
+ * It is the upper bound of a histogram bucket, So it is up to 2x the real value.
+ *
+ * Parameter hist:     The histogram of an operation.
+ * Parameter permille: The percentile in per mille, 500 for p50, 990 for p99, 999 for p99.9.
+ *
+ * Return: The latency in ticks, Zero if no call is recorded.
+ */
+uint32_t
+spritz_stats_percentile(const spritz_stats_hist *hist, uint16_t permille);
+
+/** spritz_stats_text()
+ * Write a snapshot as a text table, A line per operation:
+ * Name, count, min, p50, p99, p999, max, Separated by tabs.
+ *
+ * Parameter stats:  The snapshot.
+ * Parameter buf:    The text output, Always terminated by a null character.
+ * Parameter buflen: Size of `buf` in bytes, The text is cut if it is too small.
+ *
+ * Return: Length of the text in bytes, Without the null character.
+ */
+uint16_t
+spritz_stats_text(const spritz_stats *stats, char *buf, uint16_t bufLen);
+
+/** spritz_stats_json()
+ * Write a snapshot as a JSON object, Like:
+ * {"setup":{"count":1,"min":9,"p50":9,"p99":9,"p999":9,"max":9},"crypt":{...},...}
+ *
+ * Parameter stats:  The snapshot.
+ * Parameter buf:    The JSON output, Always terminated by a null character.
+ * Parameter buflen: Size of `buf` in bytes, The JSON is cut if it is too small.
+ *
+ * Return: Length of the JSON in bytes, Without the null character.
+ */
+uint16_t
+spritz_stats_json(const spritz_stats *stats, char *buf, uint16_t bufLen);
+#endif
 
 #ifdef __cplusplus
 }
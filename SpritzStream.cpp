@@ -0,0 +1,276 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2020 Abderraouf Adjal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#include "SpritzStream.h"
+
+
+SpritzStream::SpritzStream(Stream &io)
+  : _io(io), _tx_len(0), _tx_frame_len(0), _tx_frame_pos(0),
+    _rx_frame_len(0), _rx_len(0), _rx_pos(0), _rx_ready(0), _rx_error(0)
+{
+}
+
+/** begin()
+ * Setup both directions with a key and nonce/salt/iv.
+ *
+ * Parameter key:      The key.
+ * Parameter keylen:   Length of the key in bytes.
+ * Parameter nonce:    The nonce (salt), Never reuse it with the same key.
+ * Parameter noncelen: Length of the nonce in bytes.
+ * Parameter role:     SPRITZ_STREAM_INITIATOR or SPRITZ_STREAM_RESPONDER.
+ */
+void
+SpritzStream::begin(const uint8_t *key, uint8_t keyLen,
+                    const uint8_t *nonce, uint8_t nonceLen,
+                    uint8_t role)
+{
+  uint8_t label;
+
+  /* The initiator sends with label 0 and receives with label 1, The responder does the opposite */
+  label = (uint8_t)(role ? SPRITZ_STREAM_RESPONDER : SPRITZ_STREAM_INITIATOR);
+  spritz_setup_withIV(&_tx_ctx, key, keyLen, nonce, nonceLen);
+  spritz_add_entropy(&_tx_ctx, &label, 1);
+
+  label ^= 1;
+  spritz_setup_withIV(&_rx_ctx, key, keyLen, nonce, nonceLen);
+  spritz_add_entropy(&_rx_ctx, &label, 1);
+
+  _tx_len       = 0;
+  _tx_frame_len = 0;
+  _tx_frame_pos = 0;
+  _rx_frame_len = 0;
+  _rx_len       = 0;
+  _rx_pos       = 0;
+  _rx_ready     = 0;
+  _rx_error     = 0;
+  clearWriteError();
+}
+
+/** end()
+ * Wipe the states and the buffers, Unsent data will be lost.
+ */
+void
+SpritzStream::end()
+{
+  spritz_state_memzero(&_tx_ctx);
+  spritz_state_memzero(&_rx_ctx);
+  spritz_memzero(_tx_buf, (uint16_t)(sizeof(_tx_buf)));
+  spritz_memzero(_tx_frame, (uint16_t)(sizeof(_tx_frame)));
+  spritz_memzero(_rx_buf, (uint16_t)(sizeof(_rx_buf)));
+
+  _tx_len       = 0;
+  _tx_frame_len = 0;
+  _tx_frame_pos = 0;
+  _rx_frame_len = 0;
+  _rx_len       = 0;
+  _rx_pos       = 0;
+  _rx_ready     = 0;
+}
+
+/** authError()
+ * Return: Non-zero value if a received frame was malformed or failed authentication.
+ */
+uint8_t
+SpritzStream::authError() const
+{
+  return _rx_error;
+}
+
+
+/* Send the rest of the sealed frame,
+ * Return non-zero if it is all sent (Or there is none).
+ */
+uint8_t
+SpritzStream::sendFrame()
+{
+  size_t n;
+
+  while (_tx_frame_pos < _tx_frame_len) {
+    n = _io.write(_tx_frame + _tx_frame_pos, (size_t)(_tx_frame_len - _tx_frame_pos));
+    if (!n) {
+      return 0;
+    }
+    _tx_frame_pos = (uint16_t)(_tx_frame_pos + n);
+  }
+  _tx_frame_len = 0;
+  _tx_frame_pos = 0;
+  return 1;
+}
+
+/* Encrypt the buffered block as one frame and send it,
+ * The previous frame MUST be all sent.
+ */
+void
+SpritzStream::sealBlock()
+{
+  _tx_frame[0] = _tx_len;
+  spritz_crypt(&_tx_ctx, _tx_buf, _tx_len, _tx_frame + 1);
+  spritz_add_entropy(&_tx_ctx, _tx_buf, _tx_len);
+  spritz_add_entropy(&_tx_ctx, &_tx_len, 1);
+  spritz_hash_final(&_tx_ctx, _tx_frame + 1 + _tx_len, SPRITZ_STREAM_TAG_SIZE);
+
+  _tx_frame_len = (uint16_t)(1 + _tx_len + SPRITZ_STREAM_TAG_SIZE);
+  _tx_frame_pos = 0;
+
+#ifdef SPRITZ_WIPE_TRACES_PARANOID
+  spritz_memzero(_tx_buf, _tx_len);
+#endif
+  _tx_len = 0;
+
+  sendFrame();
+}
+
+/* Decrypt and verify a complete received frame */
+void
+SpritzStream::openFrame()
+{
+  uint8_t tag[SPRITZ_STREAM_TAG_SIZE];
+
+  spritz_crypt(&_rx_ctx, _rx_buf, _rx_frame_len, _rx_buf);
+  spritz_add_entropy(&_rx_ctx, _rx_buf, _rx_frame_len);
+  spritz_add_entropy(&_rx_ctx, &_rx_frame_len, 1);
+  spritz_hash_final(&_rx_ctx, tag, SPRITZ_STREAM_TAG_SIZE);
+
+  if (spritz_compare(tag, _rx_buf + _rx_frame_len, SPRITZ_STREAM_TAG_SIZE)) {
+    /* Never release unauthenticated data */
+    spritz_memzero(_rx_buf, (uint16_t)(sizeof(_rx_buf)));
+    _rx_error = 1;
+  }
+  else {
+    _rx_pos   = 0;
+    _rx_ready = 1;
+  }
+}
+
+/* Move the available bytes of `_io` into the frame buffer, Until a frame is ready */
+void
+SpritzStream::receive()
+{
+  int c;
+
+  while (!_rx_ready && !_rx_error && (c = _io.read()) >= 0) {
+    if (!_rx_frame_len) {
+      if (c == 0 || c > SPRITZ_STREAM_BLOCK_SIZE) {
+        _rx_error = 1;
+      }
+      _rx_frame_len = (uint8_t)c;
+      _rx_len       = 0;
+    }
+    else {
+      _rx_buf[_rx_len++] = (uint8_t)c;
+      if (_rx_len == (uint16_t)(_rx_frame_len + SPRITZ_STREAM_TAG_SIZE)) {
+        openFrame();
+      }
+    }
+  }
+}
+
+
+int
+SpritzStream::available()
+{
+  receive();
+  return _rx_ready ? (int)(_rx_frame_len - _rx_pos) : 0;
+}
+
+int
+SpritzStream::read()
+{
+  uint8_t b;
+
+  receive();
+  if (!_rx_ready) {
+    return -1;
+  }
+
+  b = _rx_buf[_rx_pos++];
+  if (_rx_pos == _rx_frame_len) {
+#ifdef SPRITZ_WIPE_TRACES_PARANOID
+    spritz_memzero(_rx_buf, _rx_frame_len);
+#endif
+    _rx_ready     = 0;
+    _rx_frame_len = 0;
+  }
+  return b;
+}
+
+int
+SpritzStream::peek()
+{
+  receive();
+  return _rx_ready ? _rx_buf[_rx_pos] : -1;
+}
+
+size_t
+SpritzStream::write(uint8_t b)
+{
+  return write(&b, 1);
+}
+
+size_t
+SpritzStream::write(const uint8_t *buf, size_t len)
+{
+  size_t i;
+  uint8_t n;
+
+  for (i = 0; i < len; i += n) {
+    if (_tx_len == SPRITZ_STREAM_BLOCK_SIZE) {
+      /* The block waits for the previous frame to be sent */
+      if (!sendFrame()) {
+        setWriteError();
+        return i;
+      }
+      sealBlock();
+    }
+    n = (uint8_t)(SPRITZ_STREAM_BLOCK_SIZE - _tx_len);
+    if (n > len - i) {
+      n = (uint8_t)(len - i);
+    }
+    memcpy(_tx_buf + _tx_len, buf + i, n);
+    _tx_len = (uint8_t)(_tx_len + n);
+    if (_tx_len == SPRITZ_STREAM_BLOCK_SIZE && sendFrame()) {
+      sealBlock();
+    }
+  }
+  return len;
+}
+
+/** flush()
+ * Send the rest of an unsent frame and the buffered bytes as a (short) frame,
+ * Then flush the underlying stream. If the underlying stream does not accept
+ * all of it, The rest is kept and getWriteError() is set, Call flush() again later.
+ */
+void
+SpritzStream::flush()
+{
+  if (sendFrame() && _tx_len) {
+    sealBlock();
+  }
+  if (_tx_frame_len) {
+    setWriteError();
+  }
+  _io.flush();
+}
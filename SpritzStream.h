@@ -0,0 +1,133 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2020 Abderraouf Adjal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#ifndef SPRITZSTREAM_H
+#define SPRITZSTREAM_H
+
+#include <Arduino.h> /* Stream */
+#include "SpritzCipher.h"
+
+
+/** SPRITZ_STREAM_BLOCK_SIZE
+ * Maximum plaintext bytes per frame, Bytes written are buffered until a block
+ * is full or flush() is called, then the block is encrypted in one pass.
+ * 64 is N/4, The block size of Spritz's AE mode in the Spritz paper.
+ * Values from 1 to 255 are valid, Both ends of a link MUST use the same value.
+ */
+#define SPRITZ_STREAM_BLOCK_SIZE 64
+
+/** SPRITZ_STREAM_TAG_SIZE
+ * Length of the authentication tag appended to every frame in bytes.
+ */
+#define SPRITZ_STREAM_TAG_SIZE 8
+
+/** SPRITZ_STREAM_INITIATOR, SPRITZ_STREAM_RESPONDER
+ * The role of a SpritzStream end, The two ends of a link MUST use different roles,
+ * So each direction has its own keystream even if they share the key and nonce.
+ */
+#define SPRITZ_STREAM_INITIATOR 0
+#define SPRITZ_STREAM_RESPONDER 1
+
+
+/** SpritzStream
+ * Authenticated encryption for any Arduino Stream (Serial, WiFiClient, ...).
+ *
+ * Written bytes are collected in a block buffer and encrypted a block at a time,
+ * Each block is sent as a frame: |length (1 byte)|ciphertext|tag|.
+ * The tag authenticates the frame and all the frames before it.
+ * Received frames are buffered and verified before any of its bytes is returned by read().
+ *
+ * Each direction uses one spritz_ctx as a duplex (SpongeWrap like) construction,
+ * The keystream encrypts the block then the plaintext is absorbed and the tag is squeezed.
+ *
+ * If the underlying stream accepts only a part of a frame (Like a full buffer),
+ * The rest of the frame is kept and sent first by the next write() or flush(),
+ * And when a new block can not be accepted write() returns less than asked and
+ * sets getWriteError(). No frame is ever cut, So the peer stays in sync.
+ */
+class SpritzStream : public Stream
+{
+  public:
+    SpritzStream(Stream &io);
+
+    /** begin()
+     * Setup both directions with a key and nonce/salt/iv.
+     *
+     * Parameter key:      The key.
+     * Parameter keylen:   Length of the key in bytes.
+     * Parameter nonce:    The nonce (salt), Never reuse it with the same key.
+     * Parameter noncelen: Length of the nonce in bytes.
+     * Parameter role:     SPRITZ_STREAM_INITIATOR or SPRITZ_STREAM_RESPONDER.
+     */
+    void begin(const uint8_t *key, uint8_t keyLen,
+               const uint8_t *nonce, uint8_t nonceLen,
+               uint8_t role);
+
+    /** end()
+     * Wipe the states and the buffers, Unsent data will be lost.
+     */
+    void end();
+
+    /** authError()
+     * Return: Non-zero value if a received frame was malformed or failed authentication.
+     *         After that no more data will be returned until begin() is called again.
+     */
+    uint8_t authError() const;
+
+    int available();
+    int read();
+    int peek();
+    size_t write(uint8_t b);
+    size_t write(const uint8_t *buf, size_t len);
+    void flush();
+    using Print::write;
+
+  private:
+    uint8_t sendFrame();
+    void sealBlock();
+    void openFrame();
+    void receive();
+
+    Stream &_io;
+
+    spritz_ctx _tx_ctx;
+    uint8_t _tx_buf[SPRITZ_STREAM_BLOCK_SIZE];
+    uint8_t _tx_len;
+    uint8_t _tx_frame[1 + SPRITZ_STREAM_BLOCK_SIZE + SPRITZ_STREAM_TAG_SIZE];
+    uint16_t _tx_frame_len; /* Length of the sealed frame in `_tx_frame` */
+    uint16_t _tx_frame_pos; /* Sent bytes of the sealed frame */
+
+    spritz_ctx _rx_ctx;
+    uint8_t _rx_buf[SPRITZ_STREAM_BLOCK_SIZE + SPRITZ_STREAM_TAG_SIZE];
+    uint8_t _rx_frame_len; /* Zero while waiting for the frame length byte */
+    uint16_t _rx_len; /* Received bytes (ciphertext and tag) of the current frame */
+    uint8_t _rx_pos; /* Next plaintext byte to read() */
+    uint8_t _rx_ready; /* Non-zero if `_rx_buf` holds a verified plaintext */
+    uint8_t _rx_error;
+};
+
+
+#endif /* SpritzStream.h */
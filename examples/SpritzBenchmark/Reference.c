@@ -0,0 +1,259 @@
+/**
+ * Small reference implementations of RC4, ChaCha20 and BLAKE2s,
+ * Only for comparison with Spritz in the SpritzBenchmark example.
+ *
+ * This code is in the public domain.
+ */
+
+#include "Reference.h"
+
+
+/* |====================|| RC4 ||====================| */
+
+void
+rc4_setup(rc4_ctx *ctx, const uint8_t *key, uint8_t keyLen)
+{
+  uint8_t t, j = 0;
+  uint16_t i;
+
+  for (i = 0; i < 256; i++) {
+    ctx->s[i] = (uint8_t)i;
+  }
+  for (i = 0; i < 256; i++) {
+    j = (uint8_t)(j + ctx->s[i] + key[i % keyLen]);
+    t = ctx->s[i];
+    ctx->s[i] = ctx->s[j];
+    ctx->s[j] = t;
+  }
+  ctx->i = 0;
+  ctx->j = 0;
+}
+
+void
+rc4_crypt(rc4_ctx *ctx, const uint8_t *data, uint16_t dataLen, uint8_t *dataOut)
+{
+  uint8_t t, i = ctx->i, j = ctx->j;
+  uint16_t n;
+
+  for (n = 0; n < dataLen; n++) {
+    i++;
+    j = (uint8_t)(j + ctx->s[i]);
+    t = ctx->s[i];
+    ctx->s[i] = ctx->s[j];
+    ctx->s[j] = t;
+    dataOut[n] = data[n] ^ ctx->s[(uint8_t)(ctx->s[i] + ctx->s[j])];
+  }
+  ctx->i = i;
+  ctx->j = j;
+}
+
+
+/* |====================|| ChaCha20 ||====================| */
+
+#define ROTL32(v, n) ((uint32_t)(((v) << (n)) | ((v) >> (32 - (n)))))
+
+static uint32_t
+load32_le(const uint8_t *p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void
+store32_le(uint8_t *p, uint32_t v)
+{
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+#define QUARTERROUND(a, b, c, d) \
+  do { \
+    a += b; d ^= a; d = ROTL32(d, 16); \
+    c += d; b ^= c; b = ROTL32(b, 12); \
+    a += b; d ^= a; d = ROTL32(d, 8); \
+    c += d; b ^= c; b = ROTL32(b, 7); \
+  } while (0)
+
+static void
+chacha20_block(chacha20_ctx *ctx)
+{
+  uint32_t x[16];
+  uint8_t i;
+
+  for (i = 0; i < 16; i++) {
+    x[i] = ctx->state[i];
+  }
+  for (i = 0; i < 10; i++) {
+    QUARTERROUND(x[0], x[4], x[8], x[12]);
+    QUARTERROUND(x[1], x[5], x[9], x[13]);
+    QUARTERROUND(x[2], x[6], x[10], x[14]);
+    QUARTERROUND(x[3], x[7], x[11], x[15]);
+    QUARTERROUND(x[0], x[5], x[10], x[15]);
+    QUARTERROUND(x[1], x[6], x[11], x[12]);
+    QUARTERROUND(x[2], x[7], x[8], x[13]);
+    QUARTERROUND(x[3], x[4], x[9], x[14]);
+  }
+  for (i = 0; i < 16; i++) {
+    store32_le(ctx->keystream + 4 * i, x[i] + ctx->state[i]);
+  }
+  ctx->state[12]++;
+  ctx->pos = 0;
+}
+
+void
+chacha20_setup(chacha20_ctx *ctx, const uint8_t key[32], const uint8_t nonce[12], uint32_t counter)
+{
+  uint8_t i;
+
+  ctx->state[0] = 0x61707865;
+  ctx->state[1] = 0x3320646e;
+  ctx->state[2] = 0x79622d32;
+  ctx->state[3] = 0x6b206574;
+  for (i = 0; i < 8; i++) {
+    ctx->state[4 + i] = load32_le(key + 4 * i);
+  }
+  ctx->state[12] = counter;
+  for (i = 0; i < 3; i++) {
+    ctx->state[13 + i] = load32_le(nonce + 4 * i);
+  }
+  ctx->pos = 64;
+}
+
+void
+chacha20_crypt(chacha20_ctx *ctx, const uint8_t *data, uint16_t dataLen, uint8_t *dataOut)
+{
+  uint16_t n;
+
+  for (n = 0; n < dataLen; n++) {
+    if (ctx->pos == 64) {
+      chacha20_block(ctx);
+    }
+    dataOut[n] = data[n] ^ ctx->keystream[ctx->pos++];
+  }
+}
+
+
+/* |====================|| BLAKE2s ||====================| */
+
+static const uint32_t blake2s_iv[8] =
+{ 0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+  0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+static const uint8_t blake2s_sigma[10][16] =
+{ {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+  { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+  { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+  {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+  {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+  {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+  { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+  { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+  {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+  { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 }
+};
+
+#define ROTR32(v, n) ((uint32_t)(((v) >> (n)) | ((v) << (32 - (n)))))
+
+#define G(a, b, c, d, x, y) \
+  do { \
+    a = a + b + (x); d = ROTR32(d ^ a, 16); \
+    c = c + d;       b = ROTR32(b ^ c, 12); \
+    a = a + b + (y); d = ROTR32(d ^ a, 8); \
+    c = c + d;       b = ROTR32(b ^ c, 7); \
+  } while (0)
+
+static void
+blake2s_compress(blake2s_ctx *ctx, uint8_t last)
+{
+  uint32_t v[16], m[16];
+  uint8_t i;
+
+  for (i = 0; i < 8; i++) {
+    v[i]     = ctx->h[i];
+    v[i + 8] = blake2s_iv[i];
+  }
+  v[12] ^= ctx->t[0];
+  v[13] ^= ctx->t[1];
+  if (last) {
+    v[14] = ~v[14];
+  }
+  for (i = 0; i < 16; i++) {
+    m[i] = load32_le(ctx->buf + 4 * i);
+  }
+  for (i = 0; i < 10; i++) {
+    const uint8_t *s = blake2s_sigma[i];
+    G(v[0], v[4], v[ 8], v[12], m[s[ 0]], m[s[ 1]]);
+    G(v[1], v[5], v[ 9], v[13], m[s[ 2]], m[s[ 3]]);
+    G(v[2], v[6], v[10], v[14], m[s[ 4]], m[s[ 5]]);
+    G(v[3], v[7], v[11], v[15], m[s[ 6]], m[s[ 7]]);
+    G(v[0], v[5], v[10], v[15], m[s[ 8]], m[s[ 9]]);
+    G(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+    G(v[2], v[7], v[ 8], v[13], m[s[12]], m[s[13]]);
+    G(v[3], v[4], v[ 9], v[14], m[s[14]], m[s[15]]);
+  }
+  for (i = 0; i < 8; i++) {
+    ctx->h[i] ^= v[i] ^ v[i + 8];
+  }
+}
+
+void
+blake2s_init(blake2s_ctx *ctx, uint8_t outLen, const uint8_t *key, uint8_t keyLen)
+{
+  uint8_t i;
+
+  for (i = 0; i < 8; i++) {
+    ctx->h[i] = blake2s_iv[i];
+  }
+  ctx->h[0] ^= 0x01010000 ^ ((uint32_t)keyLen << 8) ^ outLen;
+  ctx->t[0]   = 0;
+  ctx->t[1]   = 0;
+  ctx->len    = 0;
+  ctx->outLen = outLen;
+
+  if (keyLen) {
+    for (i = 0; i < 64; i++) {
+      ctx->buf[i] = 0;
+    }
+    blake2s_update(ctx, key, keyLen);
+    ctx->len = 64; /* The key is a full block */
+  }
+}
+
+void
+blake2s_update(blake2s_ctx *ctx, const uint8_t *data, uint16_t dataLen)
+{
+  uint16_t n;
+
+  for (n = 0; n < dataLen; n++) {
+    if (ctx->len == 64) {
+      ctx->t[0] += 64;
+      if (ctx->t[0] < 64) {
+        ctx->t[1]++;
+      }
+      blake2s_compress(ctx, 0);
+      ctx->len = 0;
+    }
+    ctx->buf[ctx->len++] = data[n];
+  }
+}
+
+void
+blake2s_final(blake2s_ctx *ctx, uint8_t *out)
+{
+  uint8_t i;
+
+  ctx->t[0] += ctx->len;
+  if (ctx->t[0] < ctx->len) {
+    ctx->t[1]++;
+  }
+  for (i = ctx->len; i < 64; i++) {
+    ctx->buf[i] = 0;
+  }
+  blake2s_compress(ctx, 1);
+
+  for (i = 0; i < ctx->outLen; i++) {
+    out[i] = (uint8_t)(ctx->h[i / 4] >> (8 * (i % 4)));
+  }
+}
@@ -0,0 +1,61 @@
+/**
+ * Small reference implementations of RC4, ChaCha20 and BLAKE2s,
+ * Only for comparison with Spritz in the SpritzBenchmark example.
+ * They are not hardened (no wiping, no side-channel care).
+ *
+ * ChaCha20 follows RFC 8439, BLAKE2s follows RFC 7693.
+ *
+ * This code is in the public domain.
+ */
+
+#ifndef REFERENCE_H
+#define REFERENCE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+typedef struct
+{
+  uint8_t s[256], i, j;
+} rc4_ctx;
+
+void rc4_setup(rc4_ctx *ctx, const uint8_t *key, uint8_t keyLen);
+void rc4_crypt(rc4_ctx *ctx, const uint8_t *data, uint16_t dataLen, uint8_t *dataOut);
+
+
+typedef struct
+{
+  uint32_t state[16];
+  uint8_t keystream[64];
+  uint8_t pos; /* Used bytes of `keystream` */
+} chacha20_ctx;
+
+void chacha20_setup(chacha20_ctx *ctx, const uint8_t key[32], const uint8_t nonce[12], uint32_t counter);
+void chacha20_crypt(chacha20_ctx *ctx, const uint8_t *data, uint16_t dataLen, uint8_t *dataOut);
+
+
+typedef struct
+{
+  uint32_t h[8], t[2];
+  uint8_t buf[64];
+  uint8_t len; /* Bytes in `buf` */
+  uint8_t outLen;
+} blake2s_ctx;
+
+/* `keyLen` zero for an unkeyed hash, Keyed (MAC) otherwise */
+void blake2s_init(blake2s_ctx *ctx, uint8_t outLen, const uint8_t *key, uint8_t keyLen);
+void blake2s_update(blake2s_ctx *ctx, const uint8_t *data, uint16_t dataLen);
+void blake2s_final(blake2s_ctx *ctx, uint8_t *out);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* Reference.h */
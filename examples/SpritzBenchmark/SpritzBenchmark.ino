@@ -0,0 +1,150 @@
+/**
+ * Spritz Cipher Benchmark
+ *
+ * This example code measure the speed of the library functions spritz_crypt(),
+ * spritz_hash() and spritz_mac(), And the setup latency (Also by key length
+ * up to 4 KB with spritz_setup_long()), Next to RC4, ChaCha20
+ * and BLAKE2s (small reference implementations in <Reference.c>) with the
+ * same data sizes on the same board, Then print the results as tables.
+ * If SPRITZ_STATS is defined, The latency percentiles recorded by the library are printed too.
+ *
+ * The circuit:  No external hardware needed.
+ *
+ * by Abderraouf Adjal.
+ *
+ * This example code is in the public domain.
+ */
+
+/* ArduinoSpritzCipher documentation: <README.md> */
+
+
+/* ArduinoSpritzCipher is configurable in <SpritzCipher.h> with:
+ * SPRITZ_TIMING_SAFE_CRUSH, SPRITZ_WIPE_TRACES, SPRITZ_WIPE_TRACES_PARANOID.
+ * For detailed information, read the documentation.
+ */
+#include <SpritzCipher.h>
+#include "Reference.h"
+
+
+#define ROUNDS 16 /* Runs of every measurement */
+#if defined(__AVR__)
+# define MAX_DATA_SIZE 256 /* Small RAM */
+#else
+# define MAX_DATA_SIZE 4096
+#endif
+
+const uint16_t dataSizes[] = { 16, 64, 256 };
+const uint16_t keySizes[] = { 16, 64, 256, 1024, 4096 };
+
+const byte testKey[32] =
+{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+  0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+  0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+const byte testNonce[12] = { 0x00 };
+
+/* Global to save stack, Data is encrypted in place */
+byte buf[MAX_DATA_SIZE];
+byte digest[32];
+spritz_ctx s_ctx;
+rc4_ctx rc4;
+chacha20_ctx chacha;
+blake2s_ctx blake;
+#ifdef SPRITZ_STATS
+spritz_stats stats; /* Snapshot of the library latency histograms */
+char statsText[400];
+#endif
+
+
+/* Run `code` ROUNDS times, Then print a table row */
+#define BENCH(name, size, code) \
+  do { \
+    unsigned long t_ = micros(); \
+    for (r = 0; r < ROUNDS; r++) { \
+      code; \
+    } \
+    printRow(name, size, micros() - t_); \
+  } while (0)
+
+void printRow(const char *name, uint16_t size, unsigned long us)
+{
+  Serial.print(name);
+  Serial.print('\t');
+  Serial.print(size);
+  Serial.print('\t');
+  Serial.print(us / ROUNDS);
+  if (size) {
+    /* KiB/s */
+    Serial.print('\t');
+    Serial.print((unsigned long)((float)size * ROUNDS * 1000000.0 / 1024.0 / (float)(us ? us : 1)));
+  }
+  Serial.println();
+}
+
+void setup() {
+  /* Initialize serial and wait for port to open */
+  Serial.begin(9600);
+  while (!Serial) {
+    ; /* Wait for serial port to connect. Needed for Leonardo only */
+  }
+}
+
+void loop() {
+  uint8_t r, n;
+  uint16_t size;
+
+  Serial.println("[Spritz library benchmark]\n");
+#ifdef SPRITZ_STATS
+  spritz_stats_reset();
+#endif
+
+  Serial.println("Setup latency (32-byte key)");
+  Serial.println("Function\tBytes\tus/op");
+  BENCH("spritz_setup", 0, spritz_setup(&s_ctx, testKey, sizeof(testKey)));
+  BENCH("spritz_setup_withIV", 0, spritz_setup_withIV(&s_ctx, testKey, sizeof(testKey), testNonce, sizeof(testNonce)));
+  BENCH("spritz_mac_setup", 0, spritz_mac_setup(&s_ctx, testKey, sizeof(testKey)));
+  BENCH("rc4_setup", 0, rc4_setup(&rc4, testKey, sizeof(testKey)));
+  BENCH("chacha20_setup", 0, chacha20_setup(&chacha, testKey, testNonce, 0));
+  BENCH("blake2s_init(key)", 0, blake2s_init(&blake, 32, testKey, sizeof(testKey)));
+  Serial.println();
+
+  Serial.println("Setup latency by key length");
+  Serial.println("Function\tBytes\tus/op\tKiB/s");
+  for (n = 0; n < sizeof(keySizes) / sizeof(keySizes[0]) && keySizes[n] <= MAX_DATA_SIZE; n++) {
+    size = keySizes[n];
+    BENCH("spritz_setup_long", size, spritz_setup_long(&s_ctx, buf, size));
+    BENCH("spritz_setup_withIV_long", size, spritz_setup_withIV_long(&s_ctx, buf, size, testNonce, sizeof(testNonce)));
+  }
+  Serial.println();
+
+  Serial.println("Throughput");
+  Serial.println("Function\tBytes\tus/op\tKiB/s");
+  spritz_setup(&s_ctx, testKey, sizeof(testKey));
+  rc4_setup(&rc4, testKey, sizeof(testKey));
+  chacha20_setup(&chacha, testKey, testNonce, 0);
+  for (n = 0; n < sizeof(dataSizes) / sizeof(dataSizes[0]); n++) {
+    size = dataSizes[n];
+    BENCH("spritz_crypt", size, spritz_crypt(&s_ctx, buf, size, buf));
+    BENCH("rc4_crypt", size, rc4_crypt(&rc4, buf, size, buf));
+    BENCH("chacha20_crypt", size, chacha20_crypt(&chacha, buf, size, buf));
+    BENCH("spritz_hash", size, spritz_hash(digest, 32, buf, size));
+    BENCH("blake2s", size,
+          blake2s_init(&blake, 32, 0, 0); blake2s_update(&blake, buf, size); blake2s_final(&blake, digest));
+    BENCH("spritz_mac", size, spritz_mac(digest, 32, buf, size, testKey, sizeof(testKey)));
+    BENCH("blake2s(key)", size,
+          blake2s_init(&blake, 32, testKey, sizeof(testKey)); blake2s_update(&blake, buf, size); blake2s_final(&blake, digest));
+  }
+
+#ifdef SPRITZ_STATS
+  /* Latency percentiles recorded by the library itself, All data sizes together */
+  Serial.println();
+  Serial.println("SPRITZ_STATS latency (us)");
+  spritz_stats_snapshot(&stats);
+  spritz_stats_text(&stats, statsText, sizeof(statsText));
+  Serial.print(statsText);
+#endif
+
+  delay(5000); /* Wait 5s */
+  Serial.println();
+}
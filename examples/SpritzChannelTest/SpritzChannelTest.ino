@@ -0,0 +1,136 @@
+/**
+ * Spritz Cipher SpritzChannel Test
+ *
+ * This example code test SpritzChannel encrypted message ring:
+ * Messages are sent and received in place through a ring of 4 slots until
+ * the ring wraps around, The full ring, Bad lengths and a ring of one slot are rejected,
+ * And a changed ciphertext byte sets authError().
+ * In a real case the producer may be an interrupt and the consumer the main loop.
+ *
+ * The circuit:  No external hardware needed.
+ *
+ * by Abderraouf Adjal.
+ *
+ * This example code is in the public domain.
+ */
+
+/* ArduinoSpritzCipher documentation: <README.md> */
+
+
+/* ArduinoSpritzCipher is configurable in <SpritzCipher.h> with:
+ * SPRITZ_TIMING_SAFE_CRUSH, SPRITZ_WIPE_TRACES, SPRITZ_WIPE_TRACES_PARANOID.
+ * For detailed information, read the documentation.
+ */
+#include <SpritzCipher.h>
+#include <SpritzChannel.h>
+
+
+#define SLOTS_COUNT 4 /* Up to 3 messages in the ring */
+#define SLOT_SIZE 16
+
+const byte testKey[3] = { 0x00, 0x01, 0x02 };
+const byte testNonce[4] = { 0x00, 0x00, 0x00, 0x01 }; /* Never reuse a nonce with the same key */
+
+byte slots[SLOTS_COUNT * SPRITZ_CHANNEL_SLOT_BYTES(SLOT_SIZE)];
+SpritzChannel channel(slots, SLOTS_COUNT, SLOT_SIZE);
+SpritzChannel small(slots, 1, SLOT_SIZE);
+
+
+/* The message `n`: SLOT_SIZE bytes or less, Never the same */
+byte makeMsg(byte *msg, byte n)
+{
+  byte len = (byte)(1 + (n % SLOT_SIZE));
+  byte i;
+
+  for (i = 0; i < len; i++) {
+    msg[i] = (byte)(n + i);
+  }
+  return len;
+}
+
+void setup() {
+  /* Initialize serial and wait for port to open */
+  Serial.begin(9600);
+  while (!Serial) {
+    ; /* Wait for serial port to connect. Needed for Leonardo only */
+  }
+
+  /* initialize digital pin LED_BUILTIN (Most boards have this LED connected to digital pin 13) as an output */
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LOW);
+}
+
+void loop() {
+  byte expected[SLOT_SIZE];
+  byte expectedLen, len;
+  byte sent = 0, received = 0, round;
+  byte *p;
+  byte failed = 0;
+
+  Serial.println("[SpritzChannel test]\n");
+
+  if (channel.begin(testKey, sizeof(testKey), testNonce, sizeof(testNonce))) {
+    failed = 1;
+  }
+  /* A ring of one slot is rejected */
+  if (!small.begin(testKey, sizeof(testKey), testNonce, sizeof(testNonce))
+      || small.reserve() != NULL || !small.commit(1)) {
+    failed = 1;
+  }
+
+  /* Bad lengths are rejected */
+  if (!channel.commit(0) || !channel.commit(SLOT_SIZE + 1)) {
+    failed = 1;
+  }
+
+  /* Fill the ring then empty it, 5 times, So the indices wrap around */
+  for (round = 0; round < 5; round++) {
+    while ((p = channel.reserve()) != NULL) {
+      if (channel.commit(makeMsg(p, sent))) {
+        failed = 1;
+      }
+      sent++;
+    }
+    /* Full ring */
+    if (channel.commit(1) == 0) {
+      failed = 1;
+    }
+    while ((p = channel.receive(&len)) != NULL) {
+      expectedLen = makeMsg(expected, received);
+      if (len != expectedLen || spritz_compare(p, expected, len)) {
+        failed = 1;
+      }
+      channel.release();
+      received++;
+    }
+  }
+  Serial.print("Messages sent/received: ");
+  Serial.print(sent);
+  Serial.print('/');
+  Serial.println(received);
+  if (sent != (SLOTS_COUNT - 1) * 5 || received != sent || channel.authError()) {
+    failed = 1;
+  }
+
+  /* Change a ciphertext byte of the next message */
+  p = channel.reserve();
+  channel.commit(makeMsg(p, sent));
+  p[0] ^= 0x01;
+  if (channel.receive(&len) != NULL || !channel.authError()) {
+    failed = 1;
+  }
+  Serial.print("Changed message authError(): ");
+  Serial.println(channel.authError());
+
+  /* Check the output */
+  if (failed) {
+    /* If the output is wrong "Alert" */
+    digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
+    Serial.println("\n** WARNING: SpritzChannel test failed **");
+  }
+
+  channel.end();
+
+  delay(5000); /* Wait 5s */
+  Serial.println();
+}
@@ -24,6 +24,17 @@
 const byte testMsg[3] = { 'A', 'B', 'C' };
 const byte testKey[3] = { 0x00, 0x01, 0x02 };
 
+/* spritz_crypt_interleaved() test: Up to MAX_LANES contexts (2 and 4 lanes kernels, And the remainder lanes) */
+#if defined(RAMEND) && (RAMEND <= 0x8FF)
+# define MAX_LANES 3 /* Small RAM (Arduino Uno) */
+#else
+# define MAX_LANES 5
+#endif
+const byte testLongMsg[20] = { 'S', 'p', 'r', 'i', 't', 'z', ' ', 'i', 'n', 't',
+                               'e', 'r', 'l', 'e', 'a', 'v', 'e', 'd', '!', '!' };
+spritz_ctx lanes_ctx[MAX_LANES];
+byte lanes_buf[MAX_LANES][sizeof(testLongMsg)];
+
 
 void testFunc(const byte *msg, byte msgLen, const byte *key, byte keyLen)
 {
@@ -76,6 +87,55 @@ void testFunc(const byte *msg, byte msgLen, const byte *key, byte keyLen)
   Serial.println();
 }
 
+/* Encrypt `testLongMsg` with `ctxcount` contexts (Key testKey + lane number) by
+ * spritz_crypt_interleaved() in two chunks, And compare each lane with spritz_crypt().
+ */
+void testInterleavedFunc(byte ctxCount)
+{
+  spritz_ctx *ctx[MAX_LANES] = { 0 };
+  const byte *data[MAX_LANES] = { 0 };
+  byte *dataOut[MAX_LANES] = { 0 };
+  spritz_ctx s_ctx;
+  byte key[sizeof(testKey) + 1];
+  byte buf[sizeof(testLongMsg)];
+  byte l, failed = 0;
+
+  memcpy(key, testKey, sizeof(testKey));
+  for (l = 0; l < ctxCount; l++) {
+    key[sizeof(testKey)] = l;
+    spritz_setup(&lanes_ctx[l], key, sizeof(key));
+    ctx[l]     = &lanes_ctx[l];
+    data[l]    = testLongMsg;
+    dataOut[l] = lanes_buf[l];
+  }
+  /* Two chunks, So the lanes states are stored and loaded again */
+  spritz_crypt_interleaved(ctx, ctxCount, data, 7, dataOut);
+  for (l = 0; l < ctxCount; l++) {
+    data[l]    = testLongMsg + 7;
+    dataOut[l] = lanes_buf[l] + 7;
+  }
+  spritz_crypt_interleaved(ctx, ctxCount, data, sizeof(testLongMsg) - 7, dataOut);
+
+  for (l = 0; l < ctxCount; l++) {
+    key[sizeof(testKey)] = l;
+    spritz_setup(&s_ctx, key, sizeof(key));
+    spritz_crypt(&s_ctx, testLongMsg, sizeof(testLongMsg), buf);
+    if (spritz_compare(buf, lanes_buf[l], sizeof(buf))) {
+      failed = 1;
+    }
+  }
+
+  Serial.print("spritz_crypt_interleaved() lanes: ");
+  Serial.println(ctxCount);
+
+  /* Check the output */
+  if (failed) {
+    /* If the output is wrong "Alert" */
+    digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
+    Serial.println("\n** WARNING: Interleaved output != spritz_crypt() output **");
+  }
+}
+
 void setup() {
   /* Initialize serial and wait for port to open */
   Serial.begin(9600);
@@ -94,6 +154,10 @@ void loop() {
   /* MSG='ABC' KEY=0x00,0x01,0x02 */
   testFunc(testMsg, sizeof(testMsg), testKey, sizeof(testKey));
 
+  for (byte n = 1; n <= MAX_LANES; n++) {
+    testInterleavedFunc(n);
+  }
+
   delay(5000); /* Wait 5s */
   Serial.println();
 }
@@ -50,12 +50,34 @@ const byte testVector3[32] =
   0x0e, 0x66, 0xbf, 0x18, 0x9c, 0x63, 0xf6, 0x99
 };
 
+/* Fields ('ABC', 'spam', 'arcfour') spritz_hash_fields() test vectors,
+ * Each field is absorbed with its 16-bit length then a stop.
+ */
+const spritz_field testFields[3] =
+{ { testData1, sizeof(testData1) },
+  { testData2, sizeof(testData2) },
+  { testData3, sizeof(testData3) }
+};
+const byte testFieldsVector[32] =
+{ 0xc2, 0x1c, 0x52, 0xb7, 0x45, 0x3c, 0x1f, 0x4c,
+  0x27, 0x03, 0xb1, 0x0a, 0xe0, 0x49, 0x74, 0x1d,
+  0x36, 0xd6, 0xc4, 0x66, 0x5f, 0x6d, 0x17, 0xc9,
+  0x64, 0x40, 0x83, 0xec, 0x77, 0xb3, 0xcd, 0x14
+};
+
+/* The work context for spritz_hash_with(), spritz_hash_records() and spritz_hash_batch(), Reused by every test */
+spritz_ctx scratch_ctx;
+
 
 void testFunc(const byte ExpectedOutput[32], const byte *data, byte dataLen)
 {
   byte hashLen = 32; /* 256-bit */
   byte digest[hashLen]; /* Output buffer */
   byte digest_2[hashLen]; /* Output buffer for chunk by chunk API */
+  byte digest_3[hashLen]; /* Output buffer for spritz_hash_with() */
+  byte digest_4[hashLen]; /* Output buffer for spritz_hash_reset() */
+  byte digests[2 * hashLen]; /* Output buffer for spritz_hash_batch() */
+  spritz_message msgs[2];
   spritz_ctx hash_ctx; /* the CTX for chunk by chunk API */
   unsigned int i;
 
@@ -74,15 +96,81 @@ void testFunc(const byte ExpectedOutput[32], const byte *data, byte dataLen)
 
   spritz_hash(digest, hashLen, data, dataLen);
 
+  spritz_hash_with(&scratch_ctx, digest_3, hashLen, data, dataLen);
+
+  /* A batch of two messages, The same as spritz_hash() of each one */
+  msgs[0].data = testData1;
+  msgs[0].len  = sizeof(testData1);
+  msgs[1].data = data;
+  msgs[1].len  = dataLen;
+  spritz_hash_batch(&scratch_ctx, digests, hashLen, msgs, 2);
+
+  /* spritz_hash_reset() of a used context is the same as spritz_hash_setup() */
+  spritz_hash_setup(&hash_ctx);
+  spritz_hash_update(&hash_ctx, testData3, sizeof(testData3));
+  spritz_hash_reset(&hash_ctx);
+  spritz_hash_update(&hash_ctx, data, dataLen);
+  spritz_hash_final(&hash_ctx, digest_4, hashLen);
+
+  for (i = 0; i < sizeof(digest); i++) {
+    if (digest[i] < 0x10) { /* To print "0F" not "F" */
+      Serial.write('0');
+    }
+    Serial.print(digest[i], HEX);
+  }
+
+  /* Check the output */
+  if (spritz_compare(digest, ExpectedOutput, sizeof(digest)) || spritz_compare(digest_2, ExpectedOutput, sizeof(digest_2))
+      || spritz_compare(digest_3, ExpectedOutput, sizeof(digest_3)) || spritz_compare(digest_4, ExpectedOutput, sizeof(digest_4))
+      || spritz_compare(digests, testVector1, hashLen) || spritz_compare(digests + hashLen, ExpectedOutput, hashLen)) {
+    /* If the output is wrong "Alert" */
+    digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
+    Serial.println("\n** WARNING: Output != Test_Vector **");
+  }
+  Serial.println();
+}
+
+void testFieldsFunc()
+{
+  byte digest[32];
+  byte digest_2[32];
+  spritz_field tuple[2];
+  unsigned int i;
+  byte failed;
+
+  Serial.println("Fields: ABC, spam, arcfour");
+  spritz_hash_fields(digest, sizeof(digest), testFields, 3);
   for (i = 0; i < sizeof(digest); i++) {
     if (digest[i] < 0x10) { /* To print "0F" not "F" */
       Serial.write('0');
     }
     Serial.print(digest[i], HEX);
   }
+  Serial.println();
+  failed = spritz_compare(digest, testFieldsVector, sizeof(digest));
+
+  /* The same record with a work context */
+  spritz_hash_records(&scratch_ctx, digest_2, sizeof(digest_2), testFields, 3, 1);
+  if (spritz_compare(digest_2, testFieldsVector, sizeof(digest_2))) {
+    failed = 1;
+  }
+
+  /* The tuples ("ab", "c") and ("a", "bc") MUST have different digests */
+  tuple[0].data = (const byte *)"ab";
+  tuple[0].len  = 2;
+  tuple[1].data = (const byte *)"c";
+  tuple[1].len  = 1;
+  spritz_hash_fields(digest, sizeof(digest), tuple, 2);
+  tuple[0].len  = 1;
+  tuple[1].data = (const byte *)"bc";
+  tuple[1].len  = 2;
+  spritz_hash_fields(digest_2, sizeof(digest_2), tuple, 2);
+  if (!spritz_compare(digest, digest_2, sizeof(digest))) {
+    failed = 1;
+  }
 
   /* Check the output */
-  if (spritz_compare(digest, ExpectedOutput, sizeof(digest)) || spritz_compare(digest_2, ExpectedOutput, sizeof(digest_2))) {
+  if (failed) {
     /* If the output is wrong "Alert" */
     digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
     Serial.println("\n** WARNING: Output != Test_Vector **");
@@ -111,6 +199,8 @@ void loop() {
   testFunc(testVector2, testData2, sizeof(testData2));
   /* Data: arcfour */
   testFunc(testVector3, testData3, sizeof(testData3));
+  /* Fields: ABC, spam, arcfour */
+  testFieldsFunc();
 
   delay(5000); /* Wait 5s */
   Serial.println();
@@ -33,14 +33,27 @@ const byte MACtestVector[32] =
   0xce, 0x81, 0xef, 0xb1, 0x6c, 0xce, 0xc7, 0xed
 };
 
+/* The work context for spritz_mac_with(), spritz_mac_records() and spritz_mac_batch() */
+spritz_ctx scratch_ctx;
+/* The MAC state of the key for spritz_mac_records() and spritz_mac_batch() */
+spritz_ctx mac_key_ctx;
+
 
 void testFunc(const byte ExpectedOutput[32], const byte *msg, byte msgLen, const byte *key, byte keyLen)
 {
   byte macLen = 32; /* 256-bit */
   byte digest[macLen]; /* Output buffer */
+  byte digest_2[macLen]; /* Output buffer for spritz_mac_with() */
+  byte digest_3[macLen]; /* Output buffer for spritz_mac_fields() */
+  byte digest_4[macLen]; /* Output buffer for spritz_mac_records() */
+  byte digest_5[macLen]; /* Output buffer for spritz_mac_reset() */
+  byte digest_6[macLen]; /* Output buffer for spritz_mac_batch() */
+  spritz_message message;
+  spritz_field field;
   unsigned int i;
 
   spritz_mac(digest, macLen, msg, msgLen, key, keyLen);
+  spritz_mac_with(&scratch_ctx, digest_2, macLen, msg, msgLen, key, keyLen);
 
   for (i = 0; i < sizeof(digest); i++) {
     if (digest[i] < 0x10) { /* To print "0F" not "F" */
@@ -49,8 +62,30 @@ void testFunc(const byte ExpectedOutput[32], const byte *msg, byte msgLen, const
     Serial.print(digest[i], HEX);
   }
 
+  /* A record of one field, Same as spritz_mac_fields() */
+  field.data = msg;
+  field.len  = msgLen;
+  spritz_mac_fields(digest_3, macLen, &field, 1, key, keyLen);
+  spritz_mac_setup(&mac_key_ctx, key, keyLen);
+  spritz_mac_records(&scratch_ctx, digest_4, macLen, &field, 1, 1, &mac_key_ctx);
+
+  /* spritz_mac_reset() of a used context is the same as spritz_mac_setup() */
+  spritz_mac_setup(&scratch_ctx, msg, msgLen);
+  spritz_mac_update(&scratch_ctx, key, keyLen);
+  spritz_mac_reset(&scratch_ctx, key, keyLen);
+  spritz_mac_update(&scratch_ctx, msg, msgLen);
+  spritz_mac_final(&scratch_ctx, digest_5, macLen);
+
+  /* A batch of one message, The same as spritz_mac() */
+  message.data = msg;
+  message.len  = msgLen;
+  spritz_mac_batch(&scratch_ctx, digest_6, macLen, &message, 1, &mac_key_ctx);
+  spritz_state_memzero(&mac_key_ctx);
+
   /* Check the output */
-  if (spritz_compare(digest, ExpectedOutput, sizeof(digest))) {
+  if (spritz_compare(digest, ExpectedOutput, sizeof(digest)) || spritz_compare(digest_2, ExpectedOutput, sizeof(digest_2))
+      || spritz_compare(digest_3, digest_4, sizeof(digest_3)) || spritz_compare(digest_5, ExpectedOutput, sizeof(digest_5))
+      || spritz_compare(digest_6, ExpectedOutput, sizeof(digest_6))) {
     /* If the output is wrong "Alert" */
     digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
     Serial.println("\n** WARNING: Output != Test_Vector **");
@@ -0,0 +1,130 @@
+/**
+ * Spritz Cipher Nonce Allocator Test
+ *
+ * This example code test the counter nonces allocator `spritz_nonce_ctx`:
+ * Resets are simulated by setting it up again from the persisted high-water mark,
+ * No counter may be given twice, And the mark is persisted once per `step` counters.
+ * Then the last counters up to 0xffffffff are given, And no more after that.
+ * The mark is stored in a RAM variable, In a real case it will be in EEPROM or flash.
+ *
+ * The circuit:  No external hardware needed.
+ *
+ * by Abderraouf Adjal.
+ *
+ * This example code is in the public domain.
+ */
+
+/* ArduinoSpritzCipher documentation: <README.md> */
+
+
+/* ArduinoSpritzCipher is configurable in <SpritzCipher.h> with:
+ * SPRITZ_TIMING_SAFE_CRUSH, SPRITZ_WIPE_TRACES, SPRITZ_WIPE_TRACES_PARANOID.
+ * For detailed information, read the documentation.
+ */
+#include <SpritzCipher.h>
+
+
+#define STEP 16 /* Counters reserved by a write */
+#define COUNTERS_PER_BOOT 40
+#define BOOTS 4
+
+uint32_t storedMark; /* The "EEPROM" */
+uint16_t persistCount;
+
+spritz_nonce_ctx nonces;
+
+
+/* Store the high-water mark, Return zero on success */
+uint8_t persistMark(uint32_t highWaterMark)
+{
+  storedMark = highWaterMark;
+  persistCount++;
+  return 0;
+}
+
+/* Counter of a 4 bytes nonce (Little-endian) */
+uint32_t nonceCounter(const byte *nonce)
+{
+  return (uint32_t)nonce[0] | ((uint32_t)nonce[1] << 8)
+         | ((uint32_t)nonce[2] << 16) | ((uint32_t)nonce[3] << 24);
+}
+
+void setup() {
+  /* Initialize serial and wait for port to open */
+  Serial.begin(9600);
+  while (!Serial) {
+    ; /* Wait for serial port to connect. Needed for Leonardo only */
+  }
+
+  /* initialize digital pin LED_BUILTIN (Most boards have this LED connected to digital pin 13) as an output */
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LOW);
+}
+
+void loop() {
+  byte nonce[4];
+  uint32_t counter, first = 0, lastGiven = 0;
+  byte boot, i, failed = 0;
+
+  Serial.println("[Spritz nonce allocator test]\n");
+
+  storedMark = 0; /* First boot */
+  for (boot = 0; boot < BOOTS; boot++) {
+    /* A reset: The allocator starts from the persisted mark */
+    spritz_nonce_setup(&nonces, storedMark, STEP, persistMark);
+    persistCount = 0;
+
+    for (i = 0; i < COUNTERS_PER_BOOT; i++) {
+      if (spritz_nonce_next(&nonces, nonce)) {
+        failed = 1;
+      }
+      counter = nonceCounter(nonce);
+      /* Never given before (Counters only increase, Even across resets),
+       * And covered by the persisted mark.
+       */
+      if ((boot || i) && counter <= lastGiven) {
+        failed = 1;
+      }
+      if (counter >= storedMark) {
+        failed = 1;
+      }
+      lastGiven = counter;
+    }
+
+    Serial.print("Boot ");
+    Serial.print(boot);
+    Serial.print(": Last counter ");
+    Serial.print(lastGiven);
+    Serial.print(", Mark ");
+    Serial.print(storedMark);
+    Serial.print(", Writes ");
+    Serial.println(persistCount);
+    /* Once per `step` counters */
+    if (persistCount > (COUNTERS_PER_BOOT / STEP) + 1) {
+      failed = 1;
+    }
+  }
+
+  /* The last 16 counters, 0xfffffff0 to 0xffffffff, Then no more, Even after a reset */
+  spritz_nonce_setup(&nonces, 0xfffffff0, STEP, persistMark);
+  if (spritz_nonce_range(&nonces, 16, &first) || first != 0xfffffff0) {
+    failed = 1;
+  }
+  if (spritz_nonce_next(&nonces, nonce) == 0) {
+    failed = 1;
+  }
+  spritz_nonce_setup(&nonces, storedMark, STEP, persistMark);
+  if (spritz_nonce_next(&nonces, nonce) == 0) {
+    failed = 1;
+  }
+
+  /* Check the output */
+  if (failed) {
+    /* If the output is wrong "Alert" */
+    digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
+    Serial.println("\n** WARNING: Nonce allocator test failed **");
+  }
+
+  delay(5000); /* Wait 5s */
+  Serial.println();
+}
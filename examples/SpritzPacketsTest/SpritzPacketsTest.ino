@@ -0,0 +1,166 @@
+/**
+ * Spritz Cipher Packets Test
+ *
+ * This example code test spritz_seal_packets() and spritz_open_packets()
+ * authenticated encryption of packets bursts (like UDP datagrams),
+ * With a forged packet and a zero tag length (That authenticates nothing),
+ * Then print the packets per second of a burst and of the one by one way
+ * (spritz_setup_withIV(), spritz_crypt() and spritz_mac() per packet).
+ *
+ * The circuit:  No external hardware needed.
+ *
+ * by Abderraouf Adjal.
+ *
+ * This example code is in the public domain.
+ */
+
+/* ArduinoSpritzCipher documentation: <README.md> */
+
+
+/* ArduinoSpritzCipher is configurable in <SpritzCipher.h> with:
+ * SPRITZ_TIMING_SAFE_CRUSH, SPRITZ_WIPE_TRACES, SPRITZ_WIPE_TRACES_PARANOID.
+ * For detailed information, read the documentation.
+ */
+#include <SpritzCipher.h>
+
+
+#define PACKETS 4
+#define PACKET_SIZE 32
+#define TAG_SIZE 8
+#define LANES 2 /* Work contexts, Packets encrypted at a time */
+#define ROUNDS 8
+
+/* Use different keys for encryption and MAC */
+const byte cryptKey[16] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+const byte macKey[16] = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f };
+
+/* Cached keyed states, Setup once */
+spritz_ctx key_ctx;
+spritz_ctx mac_key_ctx;
+spritz_ctx scratch[LANES];
+
+byte data[PACKETS][PACKET_SIZE];
+byte nonces[PACKETS][4]; /* A packet counter, Never reuse a nonce with the same key */
+byte tags[PACKETS][TAG_SIZE];
+spritz_packet packets[PACKETS];
+uint32_t counter = 0;
+
+
+void preparePackets()
+{
+  uint8_t n, i;
+
+  for (n = 0; n < PACKETS; n++) {
+    for (i = 0; i < PACKET_SIZE; i++) {
+      data[n][i] = (byte)(n + i);
+    }
+    counter++;
+    nonces[n][0] = (byte)(counter);
+    nonces[n][1] = (byte)(counter >> 8);
+    nonces[n][2] = (byte)(counter >> 16);
+    nonces[n][3] = (byte)(counter >> 24);
+
+    packets[n].data     = data[n];
+    packets[n].len      = PACKET_SIZE;
+    packets[n].nonce    = nonces[n];
+    packets[n].nonceLen = sizeof(nonces[n]);
+    packets[n].tag      = tags[n];
+  }
+}
+
+void printRate(const char *name, unsigned long us)
+{
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print((unsigned long)((float)PACKETS * ROUNDS * 1000000.0 / (float)(us ? us : 1)));
+  Serial.println(" packets/s");
+}
+
+void setup() {
+  /* Initialize serial and wait for port to open */
+  Serial.begin(9600);
+  while (!Serial) {
+    ; /* Wait for serial port to connect. Needed for Leonardo only */
+  }
+
+  /* initialize digital pin LED_BUILTIN (Most boards have this LED connected to digital pin 13) as an output */
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LOW);
+
+  spritz_key_setup(&key_ctx, cryptKey, sizeof(cryptKey));
+  spritz_mac_setup(&mac_key_ctx, macKey, sizeof(macKey));
+}
+
+void loop() {
+  unsigned long t;
+  uint8_t r, n, i;
+
+  Serial.println("[Spritz packets bursts test]\n");
+
+  /* Round trip, With a forged packet */
+  preparePackets();
+  spritz_seal_packets(&key_ctx, &mac_key_ctx, packets, PACKETS, TAG_SIZE, scratch, LANES);
+  data[1][0] ^= 0x01;
+  n = spritz_open_packets(&key_ctx, &mac_key_ctx, packets, PACKETS, TAG_SIZE, scratch, LANES);
+
+  Serial.print("Authentic packets: ");
+  Serial.println(n);
+  for (n = 0; n < PACKETS; n++) {
+    for (i = 0; i < packets[n].len; i++) {
+      if (data[n][i] != (byte)(n + i)) {
+        break;
+      }
+    }
+    /* Check the output, The packet 1 is forged */
+    if ((n == 1) != (packets[n].len == 0) || i != packets[n].len) {
+      /* If the output is wrong "Alert" */
+      digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
+      Serial.println("\n** WARNING: Output != Input **");
+    }
+  }
+
+  /* A zero tag length authenticates nothing: Sealing does nothing,
+   * And a forged packet is not accepted by opening.
+   */
+  preparePackets();
+  spritz_seal_packets(&key_ctx, &mac_key_ctx, packets, PACKETS, 0, scratch, LANES);
+  i = (data[0][0] != 0 || data[0][1] != 1); /* Not encrypted */
+  spritz_seal_packets(&key_ctx, &mac_key_ctx, packets, PACKETS, TAG_SIZE, scratch, LANES);
+  data[2][0] ^= 0x01;
+  n = spritz_open_packets(&key_ctx, &mac_key_ctx, packets, PACKETS, 0, scratch, LANES);
+  Serial.print("Authentic packets with a zero tag length: ");
+  Serial.println(n);
+  for (r = 0; r < PACKETS; r++) {
+    if (packets[r].len) {
+      i = 1;
+    }
+  }
+  if (n || i) {
+    /* If the output is wrong "Alert" */
+    digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
+    Serial.println("\n** WARNING: A zero tag length authenticated packets **");
+  }
+
+  /* Speed of a burst */
+  t = micros();
+  for (r = 0; r < ROUNDS; r++) {
+    preparePackets();
+    spritz_seal_packets(&key_ctx, &mac_key_ctx, packets, PACKETS, TAG_SIZE, scratch, LANES);
+  }
+  printRate("spritz_seal_packets()", micros() - t);
+
+  /* Speed of one by one */
+  t = micros();
+  for (r = 0; r < ROUNDS; r++) {
+    preparePackets();
+    for (n = 0; n < PACKETS; n++) {
+      spritz_setup_withIV(&scratch[0], cryptKey, sizeof(cryptKey), nonces[n], sizeof(nonces[n]));
+      spritz_crypt(&scratch[0], data[n], PACKET_SIZE, data[n]);
+      spritz_mac(tags[n], TAG_SIZE, data[n], PACKET_SIZE, macKey, sizeof(macKey));
+    }
+  }
+  printRate("One by one", micros() - t);
+
+  delay(5000); /* Wait 5s */
+  Serial.println();
+}
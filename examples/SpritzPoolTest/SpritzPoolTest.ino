@@ -0,0 +1,113 @@
+/**
+ * Spritz Cipher Random Pool Test
+ *
+ * This example code test the random bytes pool `spritz_pool`:
+ * Every given byte is wiped from the pool (Single use), And the pool bytes are
+ * the spritz_random_bytes() stream from the same seed, In the refill order.
+ *
+ * The circuit:  No external hardware needed.
+ *
+ * by Abderraouf Adjal.
+ *
+ * This example code is in the public domain.
+ */
+
+/* ArduinoSpritzCipher documentation: <README.md> */
+
+
+/* ArduinoSpritzCipher is configurable in <SpritzCipher.h> with:
+ * SPRITZ_TIMING_SAFE_CRUSH, SPRITZ_WIPE_TRACES, SPRITZ_WIPE_TRACES_PARANOID.
+ * For detailed information, read the documentation.
+ */
+#include <SpritzCipher.h>
+
+
+/* The seed, Use a real entropy (random data) in a real case */
+const byte testSeed[7] = { 'a', 'r', 'c', 'f', 'o', 'u', 'r' };
+
+#define FIRST_TAKE 10 /* Bytes taken before the first refill */
+
+spritz_pool pool;
+spritz_ctx ref_ctx;
+byte ref[2 * SPRITZ_POOL_SIZE + 16]; /* The stream from the same seed */
+byte buf[SPRITZ_POOL_SIZE];
+
+
+/* Non-zero if `len` bytes of `data` are not all zeros */
+byte notWiped(const byte *data, uint16_t len)
+{
+  byte b = 0;
+
+  while (len--) {
+    b |= *data++;
+  }
+  return b;
+}
+
+void setup() {
+  /* Initialize serial and wait for port to open */
+  Serial.begin(9600);
+  while (!Serial) {
+    ; /* Wait for serial port to connect. Needed for Leonardo only */
+  }
+
+  /* initialize digital pin LED_BUILTIN (Most boards have this LED connected to digital pin 13) as an output */
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LOW);
+}
+
+void loop() {
+  byte failed = 0;
+
+  Serial.println("[Spritz spritz_pool test]\n");
+
+  spritz_setup(&ref_ctx, testSeed, sizeof(testSeed));
+  spritz_random_bytes(&ref_ctx, ref, sizeof(ref));
+
+  /* The pool holds the stream bytes 0 to SPRITZ_POOL_SIZE-1 */
+  spritz_pool_setup(&pool, testSeed, sizeof(testSeed));
+  spritz_pool_random(&pool, buf, FIRST_TAKE);
+  if (spritz_compare(buf, ref, FIRST_TAKE)) {
+    failed = 1;
+  }
+  /* Single use: The given bytes are wiped from the pool */
+  if (notWiped(pool.buf, FIRST_TAKE)) {
+    failed = 1;
+  }
+
+  /* The refill generates the used bytes only, The next stream bytes,
+   * The unused bytes FIRST_TAKE to SPRITZ_POOL_SIZE-1 follow them.
+   */
+  spritz_pool_refill(&pool);
+  spritz_pool_random(&pool, buf, SPRITZ_POOL_SIZE);
+  if (spritz_compare(buf, ref + SPRITZ_POOL_SIZE, FIRST_TAKE)
+      || spritz_compare(buf + FIRST_TAKE, ref + FIRST_TAKE, SPRITZ_POOL_SIZE - FIRST_TAKE)) {
+    failed = 1;
+  }
+  if (notWiped(pool.buf, SPRITZ_POOL_SIZE)) {
+    failed = 1;
+  }
+
+  /* The empty pool is refilled when a byte is taken */
+  spritz_pool_random(&pool, buf, 16);
+  if (spritz_compare(buf, ref + SPRITZ_POOL_SIZE + FIRST_TAKE, 16)) {
+    failed = 1;
+  }
+  if (notWiped(pool.buf, 16)) {
+    failed = 1;
+  }
+
+  /* Check the output */
+  Serial.println(failed ? "Failed" : "OK");
+  if (failed) {
+    /* If the output is wrong "Alert" */
+    digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
+    Serial.println("\n** WARNING: Pool output != Stream **");
+  }
+
+  spritz_state_memzero(&pool.ctx);
+  spritz_state_memzero(&ref_ctx);
+
+  delay(5000); /* Wait 5s */
+  Serial.println();
+}
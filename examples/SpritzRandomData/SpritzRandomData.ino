@@ -0,0 +1,112 @@
+/**
+ * Generate reproducible pseudo-random test data from a seed at high rate.
+ *
+ * The data is made of SUBSTREAMS Spritz keystreams, Each one is setup with
+ * the seed and its index as a nonce. They are generated by spritz_random_bytes()
+ * and written in blocks of BLOCK_SIZE bytes
+ * (Block 0 of substream 0, Block 0 of substream 1, ..., Block 1 of substream 0, ...).
+ * The output is the same for the same seed, SUBSTREAMS and BLOCK_SIZE.
+ *
+ * If RAW_OUTPUT is 1, The data is written to the serial port (Save it in a file on the PC),
+ * Else only the generation rate and the hash of the data are printed,
+ * And the hash is checked with the expected one (Of the default seed and blocks layout).
+ *
+ * Do NOT use this output as keys or secrets, The seed is embedded in the code.
+ *
+ * The circuit:  No external hardware needed.
+ *
+ * by Abderraouf Adjal.
+ *
+ * This example code is in the public domain.
+ */
+
+/* ArduinoSpritzCipher documentation: <README.md> */
+
+
+/* ArduinoSpritzCipher is configurable in <SpritzCipher.h> with:
+ * SPRITZ_TIMING_SAFE_CRUSH, SPRITZ_WIPE_TRACES, SPRITZ_WIPE_TRACES_PARANOID.
+ * For detailed information, read the documentation.
+ */
+#include <SpritzCipher.h>
+
+
+#define RAW_OUTPUT 0
+#define SUBSTREAMS 2 /* 1 to 4 */
+#define BLOCK_SIZE 64
+#define TOTAL_BLOCKS 256 /* Per substream, 32 KB of data with the defaults */
+
+const byte seed[8] = { 's', 'e', 'e', 'd', '-', '0', '0', '1' };
+
+/* The hash of the data of the default seed, SUBSTREAMS, BLOCK_SIZE and TOTAL_BLOCKS */
+const byte expectedDigest[16] = { 0x36, 0x2d, 0xf4, 0x67, 0x1d, 0x5d, 0x5a, 0x06,
+                                  0x0d, 0xb0, 0x1a, 0x5f, 0xa6, 0xd5, 0x60, 0x5e };
+
+spritz_ctx substreams[SUBSTREAMS];
+spritz_ctx hash_ctx;
+byte blocks[SUBSTREAMS][BLOCK_SIZE];
+
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    ; /* Wait for serial port to connect. Needed for Leonardo only */
+  }
+
+  /* initialize digital pin LED_BUILTIN (Most boards have this LED connected to digital pin 13) as an output */
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LOW);
+}
+
+void loop() {
+  byte digest[16];
+  byte index;
+  uint16_t n;
+  unsigned long t, genTime = 0;
+
+  for (index = 0; index < SUBSTREAMS; index++) {
+    spritz_setup_withIV(&substreams[index], seed, sizeof(seed), &index, 1);
+  }
+  spritz_hash_setup(&hash_ctx);
+
+  for (n = 0; n < TOTAL_BLOCKS; n++) {
+    t = micros();
+    for (index = 0; index < SUBSTREAMS; index++) {
+      spritz_random_bytes(&substreams[index], blocks[index], BLOCK_SIZE);
+    }
+    genTime += micros() - t;
+#if RAW_OUTPUT
+    Serial.write((const byte *)blocks, sizeof(blocks));
+#else
+    spritz_hash_update(&hash_ctx, (const byte *)blocks, sizeof(blocks));
+#endif
+  }
+
+#if !RAW_OUTPUT
+  spritz_hash_final(&hash_ctx, digest, sizeof(digest));
+
+  Serial.print("Bytes: ");
+  Serial.println((unsigned long)TOTAL_BLOCKS * sizeof(blocks));
+  Serial.print("Generated bytes/s: ");
+  Serial.println((unsigned long)((float)TOTAL_BLOCKS * sizeof(blocks) * 1000000.0 / (float)(genTime ? genTime : 1)));
+
+  /* The same digest for the same seed and blocks layout */
+  Serial.print("Hash: ");
+  for (index = 0; index < sizeof(digest); index++) {
+    if (digest[index] < 0x10) { /* To print "0F", not "F" */
+      Serial.write('0');
+    }
+    Serial.print(digest[index], HEX);
+  }
+  Serial.println();
+
+  /* Check the output */
+  if (SUBSTREAMS == 2 && BLOCK_SIZE == 64 && TOTAL_BLOCKS == 256
+      && spritz_compare(digest, expectedDigest, sizeof(digest))) {
+    /* If the output is wrong "Alert" */
+    digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
+    Serial.println("\n** WARNING: Output != Test_Vector **");
+  }
+#endif
+
+  delay(5000); /* Wait 5s */
+}
@@ -0,0 +1,120 @@
+/**
+ * Spritz Cipher Shuffle Test
+ *
+ * This example code test spritz_shuffle():
+ * The output is a permutation of the records (Every record once),
+ * And the same seed gives the same order (Checked with expected orders).
+ * 16 records use one random byte per index, 300 records two bytes.
+ *
+ * The circuit:  No external hardware needed.
+ *
+ * by Abderraouf Adjal.
+ *
+ * This example code is in the public domain.
+ */
+
+/* ArduinoSpritzCipher documentation: <README.md> */
+
+
+/* ArduinoSpritzCipher is configurable in <SpritzCipher.h> with:
+ * SPRITZ_TIMING_SAFE_CRUSH, SPRITZ_WIPE_TRACES, SPRITZ_WIPE_TRACES_PARANOID.
+ * For detailed information, read the documentation.
+ */
+#include <SpritzCipher.h>
+
+
+/* The seed */
+const byte testSeed[7] = { 'a', 'r', 'c', 'f', 'o', 'u', 'r' };
+
+#define SMALL_COUNT 16
+#define LARGE_COUNT 300
+
+/* The order of SMALL_COUNT records shuffled from the seed */
+const byte testVectorSmall[SMALL_COUNT] = { 7, 12, 6, 4, 14, 8, 5, 2, 1, 9, 0, 11, 3, 13, 15, 10 };
+/* The first 8 records of LARGE_COUNT records shuffled from the seed */
+const uint16_t testVectorLarge[8] = { 269, 57, 37, 43, 109, 294, 281, 214 };
+
+spritz_ctx s_ctx;
+uint16_t records[LARGE_COUNT];
+byte seen[(LARGE_COUNT + 7) / 8]; /* A bit per record */
+
+
+/* Shuffle the records 0 to `count - 1` from the seed, Return non-zero if it is not a permutation */
+byte shuffleRecords(uint16_t count)
+{
+  uint16_t i;
+  byte failed = 0;
+
+  for (i = 0; i < count; i++) {
+    records[i] = i;
+  }
+  spritz_setup(&s_ctx, testSeed, sizeof(testSeed));
+  spritz_shuffle(&s_ctx, (byte *)records, count, sizeof(records[0]));
+
+  /* Every record once */
+  spritz_memzero(seen, sizeof(seen));
+  for (i = 0; i < count; i++) {
+    if (records[i] >= count || (seen[records[i] / 8] & (1 << (records[i] % 8)))) {
+      failed = 1;
+    }
+    else {
+      seen[records[i] / 8] |= (byte)(1 << (records[i] % 8));
+    }
+  }
+  return failed;
+}
+
+void setup() {
+  /* Initialize serial and wait for port to open */
+  Serial.begin(9600);
+  while (!Serial) {
+    ; /* Wait for serial port to connect. Needed for Leonardo only */
+  }
+
+  /* initialize digital pin LED_BUILTIN (Most boards have this LED connected to digital pin 13) as an output */
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LOW);
+}
+
+void loop() {
+  uint16_t i;
+  byte failed = 0;
+
+  Serial.println("[Spritz spritz_shuffle() test]\n");
+
+  if (shuffleRecords(SMALL_COUNT)) {
+    failed = 1;
+  }
+  for (i = 0; i < SMALL_COUNT; i++) {
+    Serial.print(records[i]);
+    Serial.print(' ');
+    if (records[i] != testVectorSmall[i]) {
+      failed = 1;
+    }
+  }
+  Serial.println();
+
+  if (shuffleRecords(LARGE_COUNT)) {
+    failed = 1;
+  }
+  for (i = 0; i < 8; i++) {
+    Serial.print(records[i]);
+    Serial.print(' ');
+    if (records[i] != testVectorLarge[i]) {
+      failed = 1;
+    }
+  }
+  Serial.println("...");
+
+  /* Check the output */
+  if (failed) {
+    /* If the output is wrong "Alert" */
+    digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
+    Serial.println("\n** WARNING: Output != Test_Vector **");
+  }
+
+  spritz_state_memzero(&s_ctx);
+
+  delay(5000); /* Wait 5s */
+  Serial.println();
+}
@@ -0,0 +1,157 @@
+/**
+ * Spritz Cipher SpritzStream Test
+ *
+ * This example code test SpritzStream authenticated encryption of a byte stream.
+ * Two SpritzStream ends are connected by a loopback buffer in RAM,
+ * In a real case it will be a Serial port or a network client.
+ * The message is sent in three frames (Two full blocks and a short one),
+ * Then again with a changed byte in the second frame, That MUST set authError().
+ *
+ * The circuit:  No external hardware needed.
+ *
+ * by Abderraouf Adjal.
+ *
+ * This example code is in the public domain.
+ */
+
+/* ArduinoSpritzCipher documentation: <README.md> */
+
+
+/* ArduinoSpritzCipher is configurable in <SpritzCipher.h> with:
+ * SPRITZ_TIMING_SAFE_CRUSH, SPRITZ_WIPE_TRACES, SPRITZ_WIPE_TRACES_PARANOID.
+ * For detailed information, read the documentation.
+ */
+#include <SpritzCipher.h>
+#include <SpritzStream.h>
+
+
+/* A Stream that returns what is written to it, It holds 255 bytes */
+class LoopbackStream : public Stream
+{
+  public:
+    LoopbackStream() : head(0), tail(0) {}
+
+    int available() { return (uint8_t)(head - tail); }
+    int peek() { return (head == tail) ? -1 : buf[tail]; }
+    int read() {
+      int c = peek();
+      if (c >= 0) {
+        tail++;
+      }
+      return c;
+    }
+    size_t write(uint8_t b) {
+      if ((uint8_t)(head + 1) == tail) {
+        return 0; /* Full */
+      }
+      buf[head++] = b;
+      return 1;
+    }
+    using Print::write;
+
+    /* Change the unread byte at `index`, Like a noisy link or an attacker */
+    void flip(uint8_t index) { buf[(uint8_t)(tail + index)] ^= 0x01; }
+
+  private:
+    uint8_t buf[256];
+    uint8_t head, tail; /* Wrap around at 256 */
+};
+
+
+/* Data to input */
+const char testMsg[] = "Spritz - a spongy RC4-like stream cipher and hash function.";
+const byte testKey[3] = { 0x00, 0x01, 0x02 };
+const byte testNonce[4] = { 0x00, 0x00, 0x00, 0x01 }; /* Never reuse a nonce with the same key */
+
+LoopbackStream wire;
+SpritzStream sender(wire);
+SpritzStream receiver(wire);
+
+
+void setup() {
+  /* Initialize serial and wait for port to open */
+  Serial.begin(9600);
+  while (!Serial) {
+    ; /* Wait for serial port to connect. Needed for Leonardo only */
+  }
+
+  /* initialize digital pin LED_BUILTIN (Most boards have this LED connected to digital pin 13) as an output */
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LOW);
+}
+
+/* Send `testMsg` MSG_COPIES times (More than two blocks, So three frames),
+ * Change the byte `flipIndex` of the frames if it is not negative,
+ * Then receive and check the bytes.
+ *
+ * Return: The number of correct bytes received.
+ */
+#define MSG_COPIES 3
+unsigned int testFunc(int flipIndex)
+{
+  unsigned int i = 0, n;
+  int c;
+
+  sender.begin(testKey, sizeof(testKey), testNonce, sizeof(testNonce), SPRITZ_STREAM_INITIATOR);
+  receiver.begin(testKey, sizeof(testKey), testNonce, sizeof(testNonce), SPRITZ_STREAM_RESPONDER);
+
+  /* Bytes are buffered, Then encrypted a block at a time */
+  for (n = 0; n < MSG_COPIES; n++) {
+    sender.print(testMsg);
+  }
+  sender.flush();
+
+  Serial.print("Frames size: ");
+  Serial.println(wire.available());
+
+  if (flipIndex >= 0) {
+    wire.flip((uint8_t)flipIndex);
+  }
+
+  while ((c = receiver.read()) >= 0 && (byte)c == (byte)testMsg[i % (sizeof(testMsg) - 1)]) {
+    Serial.write((byte)c);
+    i++;
+  }
+  Serial.println();
+
+  /* Empty the link for the next test */
+  while (wire.read() >= 0) {
+    ;
+  }
+  return i;
+}
+
+void loop() {
+  unsigned int received;
+  byte failed = 0;
+
+  Serial.println("[SpritzStream encryption/decryption test]\n");
+
+  received = testFunc(-1);
+  if (received != MSG_COPIES * (sizeof(testMsg) - 1) || receiver.authError() || sender.getWriteError()) {
+    failed = 1;
+  }
+
+  /* Change a ciphertext byte of the second frame (Frame 1 is 1 + 64 + SPRITZ_STREAM_TAG_SIZE bytes),
+   * Only the first frame is returned, Then authError() is set.
+   */
+  received = testFunc(1 + SPRITZ_STREAM_BLOCK_SIZE + SPRITZ_STREAM_TAG_SIZE + 10);
+  Serial.print("Changed frame authError(): ");
+  Serial.println(receiver.authError());
+  if (received != SPRITZ_STREAM_BLOCK_SIZE || !receiver.authError()) {
+    failed = 1;
+  }
+
+  /* Check the output */
+  if (failed) {
+    /* If the output is wrong "Alert" */
+    digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
+    Serial.println("\n** WARNING: Output != Input **");
+  }
+
+  sender.end();
+  receiver.end();
+
+  delay(5000); /* Wait 5s */
+  Serial.println();
+}
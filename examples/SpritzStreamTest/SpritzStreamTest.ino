@@ -2,8 +2,10 @@
  * Spritz Cipher Stream Test
  *
  * This example code test SpritzCipher library stream (PRNG) output
- * using test vectors from Spritz paper "RS14.pdf" Page 30:
+ * (spritz_random8() and spritz_random_bytes()) using test vectors from Spritz paper "RS14.pdf" Page 30:
  * <https://people.csail.mit.edu/rivest/pubs/RS14.pdf>
+ * And check spritz_setup_long() and spritz_setup_withIV_long() with the setups for short keys,
+ * And with the hash and MAC setups for a 300 bytes key.
  *
  * The circuit:  No external hardware needed.
  *
@@ -79,6 +81,90 @@ void testFunc(const byte ExpectedOutput[32], const byte *data, byte dataLen)
     digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
     Serial.println("\n** WARNING: Output != Test_Vector **");
   }
+
+  /* spritz_random_bytes() output is the same as spritz_random8() output, Even in parts */
+  spritz_setup(&s_ctx, data, dataLen);
+  spritz_random_bytes(&s_ctx, buf, 1);
+  spritz_random_bytes(&s_ctx, buf + 1, 10);
+  spritz_random_bytes(&s_ctx, buf + 11, sizeof(buf) - 11);
+  if (spritz_compare(buf, ExpectedOutput, sizeof(buf))) {
+    /* If the output is wrong "Alert" */
+    digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
+    Serial.println("\n** WARNING: spritz_random_bytes() Output != Test_Vector **");
+  }
+  Serial.println();
+}
+
+/* spritz_setup_long() and spritz_setup_withIV_long() are the same as
+ * spritz_setup() and spritz_setup_withIV() for keys and nonces shorter than 256 bytes.
+ * For a longer key, They absorb it like spritz_hash_update() and spritz_mac_setup().
+ */
+byte longKey[300];
+spritz_ctx long_ctx;
+
+void testLongSetupFunc()
+{
+  const byte lens[4] = { 1, 7, 128, 255 };
+  byte buf[16];
+  byte buf_2[16];
+  spritz_ctx s_ctx;
+  unsigned int i, n;
+  byte failed = 0;
+
+  for (i = 0; i < sizeof(longKey); i++) {
+    longKey[i] = (byte)(i * 7 + 1);
+  }
+
+  for (n = 0; n < sizeof(lens); n++) {
+    spritz_setup(&s_ctx, longKey, lens[n]);
+    spritz_random_bytes(&s_ctx, buf, sizeof(buf));
+    spritz_setup_long(&long_ctx, longKey, lens[n]);
+    spritz_random_bytes(&long_ctx, buf_2, sizeof(buf_2));
+    if (spritz_compare(buf, buf_2, sizeof(buf))) {
+      failed = 1;
+    }
+
+    /* The key and the nonce of the same length, The nonce is the key end */
+    spritz_setup_withIV(&s_ctx, longKey, lens[n], longKey + sizeof(longKey) - lens[n], lens[n]);
+    spritz_random_bytes(&s_ctx, buf, sizeof(buf));
+    spritz_setup_withIV_long(&long_ctx, longKey, lens[n], longKey + sizeof(longKey) - lens[n], lens[n]);
+    spritz_random_bytes(&long_ctx, buf_2, sizeof(buf_2));
+    if (spritz_compare(buf, buf_2, sizeof(buf))) {
+      failed = 1;
+    }
+  }
+
+  /* A 300 bytes key, Absorbed by the hash setup and update (No absorbStop()),
+   * spritz_random_bytes() does the shuffle of the setup end.
+   */
+  spritz_hash_setup(&s_ctx);
+  spritz_hash_update(&s_ctx, longKey, sizeof(longKey));
+  spritz_random_bytes(&s_ctx, buf, sizeof(buf));
+  spritz_setup_long(&long_ctx, longKey, sizeof(longKey));
+  spritz_random_bytes(&long_ctx, buf_2, sizeof(buf_2));
+  if (spritz_compare(buf, buf_2, sizeof(buf))) {
+    failed = 1;
+  }
+
+  /* A 300 bytes key and nonce, The MAC setup absorbs the key then absorbStop() */
+  spritz_mac_setup(&s_ctx, longKey, sizeof(longKey));
+  spritz_add_entropy(&s_ctx, longKey, sizeof(longKey));
+  spritz_random_bytes(&s_ctx, buf, sizeof(buf));
+  spritz_setup_withIV_long(&long_ctx, longKey, sizeof(longKey), longKey, sizeof(longKey));
+  spritz_random_bytes(&long_ctx, buf_2, sizeof(buf_2));
+  if (spritz_compare(buf, buf_2, sizeof(buf))) {
+    failed = 1;
+  }
+
+  Serial.println(failed ? "spritz_setup*_long(): Failed" : "spritz_setup*_long(): OK");
+  if (failed) {
+    /* If the output is wrong "Alert" */
+    digitalWrite(LED_BUILTIN, HIGH); /* Turn pin LED_BUILTIN On (Most boards have this LED connected to digital pin 13) */
+    Serial.println("\n** WARNING: spritz_setup*_long() Output != spritz_setup*() Output **");
+  }
+
+  spritz_state_memzero(&s_ctx);
+  spritz_state_memzero(&long_ctx);
   Serial.println();
 }
 
@@ -95,7 +181,7 @@ void setup() {
 }
 
 void loop() {
-  Serial.println("[Spritz spritz_random8() test]\n");
+  Serial.println("[Spritz spritz_random8() and spritz_random_bytes() test]\n");
 
   /* Key: ABC */
   testFunc(testVector1, testKey1, sizeof(testKey1));
@@ -103,6 +189,8 @@ void loop() {
   testFunc(testVector2, testKey2, sizeof(testKey2));
   /* Key: arcfour */
   testFunc(testVector3, testKey3, sizeof(testKey3));
+  /* Keys and nonces of 1 to 255 bytes */
+  testLongSetupFunc();
 
   delay(5000); /* Wait 5s */
   Serial.println();